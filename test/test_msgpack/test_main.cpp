@@ -0,0 +1,156 @@
+/*
+ * JSON API in JSON and MessagePack: content negotiation, round trip and size/speed comparison
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "src/dependencies/json/ArduinoJson-v6.h"
+#include "const.h"
+#include "api_helpers.h"
+
+#define SEGMENTS 16
+#define STATE_DOC_SIZE (2 * JSON_BUFFER_SIZE) //ESP32 document, slots are twice as large on 64 bit hosts
+
+//the document serializeState() builds for 16 active segments: same keys in the same order,
+//"col" as raw text like serializeSegment()
+static void serializeStateLike(JsonObject root) {
+  root["on"] = true; root["bri"] = 128; root["transition"] = 7;
+  root["ps"] = -1; root["pl"] = -1;
+  JsonObject nl = root.createNestedObject("nl");
+  nl["on"] = false; nl["dur"] = 60; nl["mode"] = 1; nl["tbri"] = 0; nl["rem"] = -1;
+  JsonObject udpn = root.createNestedObject("udpn");
+  udpn["send"] = false; udpn["recv"] = true;
+  root["lor"] = 0; root["mainseg"] = 0;
+  JsonArray segs = root.createNestedArray("seg");
+  for (uint8_t i = 0; i < SEGMENTS; i++) {
+    JsonObject s = segs.createNestedObject();
+    s["id"] = i; s["start"] = i * 30; s["stop"] = i * 30 + 30; s["len"] = 30;
+    s["grp"] = 1; s["spc"] = 0; s["of"] = 0; s["on"] = true; s["frz"] = false;
+    s["bri"] = 255; s["cct"] = 127;
+    char colstr[70];
+    snprintf(colstr, sizeof(colstr), "[[%u,160,0],[0,0,%u],[0,0,0]]", 255 - i * 8, i * 16);
+    s["col"] = serialized(colstr); //copied, like the char array in serializeSegment()
+    s["fx"] = 9 + i; s["sx"] = 128; s["ix"] = 128;
+    s["pal"] = 11; s["sel"] = i == 0; s["rev"] = false; s["mi"] = false;
+  }
+}
+
+static void test_accept_negotiation() {
+  TEST_ASSERT_TRUE(isMsgPackMediaType("application/msgpack"));
+  TEST_ASSERT_TRUE(isMsgPackMediaType("application/x-msgpack"));
+  TEST_ASSERT_TRUE(isMsgPackMediaType("application/msgpack, application/json;q=0.5"));
+  TEST_ASSERT_FALSE(isMsgPackMediaType("application/json"));
+  TEST_ASSERT_FALSE(isMsgPackMediaType("*/*"));
+  TEST_ASSERT_FALSE(isMsgPackMediaType(""));
+  TEST_ASSERT_FALSE(isMsgPackMediaType(nullptr)); //no Accept header
+  TEST_ASSERT_EQUAL_STRING("application/msgpack", jsonContentType(isMsgPackMediaType("application/msgpack")));
+  TEST_ASSERT_EQUAL_STRING("application/json", jsonContentType(isMsgPackMediaType("text/html,*/*")));
+}
+
+static void test_msgpack_map_detection() {
+  const uint8_t fixmap[] = {0x81, 0xA2, 'o', 'n', 0xC3};
+  const uint8_t map16[]  = {0xDE, 0x00, 0x01};
+  const uint8_t array[]  = {0x93, 0x01, 0x02, 0x03};
+  const uint8_t pixels[] = {'P', 0, 0, 0, 3};
+  const uint8_t json[]   = {'{', '}'};
+  TEST_ASSERT_TRUE(isMsgPackMap(fixmap, sizeof(fixmap)));
+  TEST_ASSERT_TRUE(isMsgPackMap(map16, sizeof(map16)));
+  TEST_ASSERT_FALSE(isMsgPackMap(array, sizeof(array)));
+  TEST_ASSERT_FALSE(isMsgPackMap(pixels, sizeof(pixels))); //binary pixel upload
+  TEST_ASSERT_FALSE(isMsgPackMap(json, sizeof(json)));
+  TEST_ASSERT_FALSE(isMsgPackMap(fixmap, 0));
+}
+
+//the raw "col" text is not MessagePack, expandSegmentColors() turns it into the arrays it stands for
+static void test_expand_colors() {
+  DynamicJsonDocument state(STATE_DOC_SIZE), decoded(STATE_DOC_SIZE);
+  serializeStateLike(state.to<JsonObject>());
+  char* json = (char*)malloc(measureJson(state) + 1);
+  size_t jsonLen = serializeJson(state, json, measureJson(state) + 1);
+
+  size_t rawLen = measureMsgPack(state);
+  uint8_t* raw = (uint8_t*)malloc(rawLen);
+  serializeMsgPack(state, raw, rawLen);
+  TEST_ASSERT_FALSE(deserializeMsgPack(decoded, (const char*)raw, rawLen) == DeserializationError::Ok
+    && decoded["seg"][0]["col"][0][0] == 255); //colors lost or message broken
+
+  TEST_ASSERT_TRUE(expandSegmentColors(state.as<JsonObject>()));
+  TEST_ASSERT_FALSE(state.overflowed());
+  TEST_ASSERT_EQUAL(jsonLen, measureJson(state)); //same JSON text
+  TEST_ASSERT_EQUAL(255 - 8, state["seg"][1]["col"][0][0].as<int>());
+  TEST_ASSERT_EQUAL(16, state["seg"][1]["col"][1][2].as<int>());
+  TEST_ASSERT_EQUAL(3, state["seg"][15]["col"].size());
+  TEST_ASSERT_TRUE(expandSegmentColors(state.as<JsonObject>())); //already arrays
+
+  DynamicJsonDocument small(12 * 1024); //fits the state, not the arrays
+  serializeStateLike(small.to<JsonObject>());
+  TEST_ASSERT_FALSE(small.overflowed() || expandSegmentColors(small.as<JsonObject>()));
+  free(raw); free(json);
+}
+
+//the expanded state encoded both ways decodes to the same document
+static void test_round_trip() {
+  DynamicJsonDocument state(STATE_DOC_SIZE), decoded(STATE_DOC_SIZE);
+  serializeStateLike(state.to<JsonObject>());
+  TEST_ASSERT_TRUE(expandSegmentColors(state.as<JsonObject>()));
+
+  size_t jsonLen = measureJson(state), mpLen = measureMsgPack(state);
+  char* json = (char*)malloc(jsonLen + 1);
+  char* json2 = (char*)malloc(jsonLen + 1);
+  uint8_t* mp = (uint8_t*)malloc(mpLen);
+  TEST_ASSERT_EQUAL(jsonLen, serializeJson(state, json, jsonLen + 1));
+  TEST_ASSERT_EQUAL(mpLen, serializeMsgPack(state, mp, mpLen));
+  TEST_ASSERT_TRUE(isMsgPackMap(mp, mpLen));
+
+  TEST_ASSERT_TRUE(deserializeMsgPack(decoded, (const char*)mp, mpLen) == DeserializationError::Ok);
+  TEST_ASSERT_EQUAL(jsonLen, serializeJson(decoded, json2, jsonLen + 1));
+  TEST_ASSERT_EQUAL_STRING(json, json2);
+
+  TEST_ASSERT_TRUE(deserializeJson(decoded, (const char*)json, jsonLen) == DeserializationError::Ok);
+  TEST_ASSERT_EQUAL(mpLen, measureMsgPack(decoded));
+  TEST_ASSERT_TRUE(mpLen < jsonLen);
+  free(mp); free(json2); free(json);
+}
+
+//size and encode/decode time of both formats, for comparison (host timing, relative only)
+static void test_size_and_speed() {
+  const int runs = 1000;
+  DynamicJsonDocument state(STATE_DOC_SIZE), decoded(STATE_DOC_SIZE);
+  serializeStateLike(state.to<JsonObject>());
+  TEST_ASSERT_TRUE(expandSegmentColors(state.as<JsonObject>()));
+  size_t jsonLen = measureJson(state), mpLen = measureMsgPack(state);
+  char* json = (char*)malloc(jsonLen + 1);
+  uint8_t* mp = (uint8_t*)malloc(mpLen);
+
+  typedef std::chrono::steady_clock clk;
+  clk::time_point t[5];
+  t[0] = clk::now();
+  for (int i = 0; i < runs; i++) serializeJson(state, json, jsonLen + 1);
+  t[1] = clk::now();
+  for (int i = 0; i < runs; i++) serializeMsgPack(state, mp, mpLen);
+  t[2] = clk::now();
+  for (int i = 0; i < runs; i++) deserializeJson(decoded, (const char*)json, jsonLen); //copying, like the API handlers
+  t[3] = clk::now();
+  for (int i = 0; i < runs; i++) deserializeMsgPack(decoded, (const char*)mp, mpLen);
+  t[4] = clk::now();
+
+  double us[4];
+  for (uint8_t i = 0; i < 4; i++) us[i] = std::chrono::duration<double, std::micro>(t[i+1] - t[i]).count() / runs;
+  printf("state with %d segments: JSON %u bytes, MessagePack %u bytes (%u%%)\n",
+    SEGMENTS, (unsigned)jsonLen, (unsigned)mpLen, (unsigned)(mpLen * 100 / jsonLen));
+  printf("encode: JSON %.2f us, MessagePack %.2f us; decode: JSON %.2f us, MessagePack %.2f us\n",
+    us[0], us[1], us[2], us[3]);
+  TEST_ASSERT_TRUE(mpLen * 10 < jsonLen * 9); //at least 10% smaller
+  free(mp); free(json);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_accept_negotiation);
+  RUN_TEST(test_msgpack_map_detection);
+  RUN_TEST(test_expand_colors);
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_size_and_speed);
+  return UNITY_END();
+}
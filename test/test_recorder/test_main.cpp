@@ -0,0 +1,92 @@
+/*
+ * Frame recorder file format and RAM staging (bus_manager.h BusRecorder), written to a host file
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "api_helpers.h"
+
+#define PIXELS 3
+
+//host backend of BusRecorder::writeStage(): appends the staged frames to a plain file
+static uint32_t writeFile(FILE* f, const uint8_t* data, uint32_t len) {
+  return fwrite(data, 1, len, f);
+}
+
+//records frames like BusRecorder::show() (pixels nullptr = unchanged) and writes them to a file like the loop
+static long record(FILE* f, RecStage& stage, const uint8_t* const* frames, uint8_t n) {
+  uint8_t hdr[REC_HEADER_SIZE];
+  recFileHeader(hdr, PIXELS);
+  fwrite(hdr, 1, REC_HEADER_SIZE, f);
+  for (uint8_t i = 0; i < n; i++) {
+    if (!stage.add(1000 + i * 25, 128, frames[i], PIXELS * 4)) return -1;
+    if (i % 2) stage.flush([f](const uint8_t* d, uint32_t l) { return writeFile(f, d, l); });
+  }
+  stage.flush([f](const uint8_t* d, uint32_t l) { return writeFile(f, d, l); });
+  return ftell(f);
+}
+
+static void test_file_layout() {
+  static const uint8_t red[PIXELS * 4]  = {255,0,0,0, 255,0,0,0, 255,0,0,0};
+  static const uint8_t blue[PIXELS * 4] = {0,0,255,0, 0,0,255,0, 0,0,255,10};
+  const uint8_t* frames[] = {red, nullptr, nullptr, blue, nullptr};
+  RecStage stage;
+  TEST_ASSERT_TRUE(stage.begin(256));
+  FILE* f = tmpfile();
+  TEST_ASSERT_NOT_NULL(f);
+  long size = record(f, stage, frames, 5);
+  TEST_ASSERT_EQUAL(REC_HEADER_SIZE + 5 * REC_FRAME_HEADER + 2 * PIXELS * 4, size);
+  TEST_ASSERT_EQUAL(0, stage.len);
+
+  uint8_t file[128];
+  rewind(f);
+  TEST_ASSERT_EQUAL(size, fread(file, 1, sizeof(file), f));
+  fclose(f);
+  stage.end();
+
+  TEST_ASSERT_EQUAL_MEMORY("WREC", file, 4);
+  TEST_ASSERT_EQUAL(4, file[5]);
+  TEST_ASSERT_EQUAL(PIXELS, file[6] | file[7] << 8);
+  const uint8_t* p = file + REC_HEADER_SIZE;
+  for (uint8_t i = 0; i < 5; i++) {
+    uint32_t ms = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+    TEST_ASSERT_EQUAL(1000 + i * 25, ms);
+    TEST_ASSERT_EQUAL(128, p[4]);
+    TEST_ASSERT_EQUAL(frames[i] ? 0 : REC_FLAG_REPEAT, p[5]);
+    p += REC_FRAME_HEADER;
+    if (!frames[i]) continue;
+    TEST_ASSERT_EQUAL_MEMORY(frames[i], p, PIXELS * 4);
+    p += PIXELS * 4;
+  }
+  TEST_ASSERT_TRUE(p == file + size);
+}
+
+//show() never blocks: a full stage drops the frame until the loop has written it out
+static void test_full_stage_drops() {
+  static const uint8_t px[PIXELS * 4] = {0};
+  const uint32_t frame = REC_FRAME_HEADER + PIXELS * 4;
+  RecStage stage;
+  TEST_ASSERT_TRUE(stage.begin(2 * frame));
+  TEST_ASSERT_TRUE(stage.add(0, 255, px, sizeof(px)));
+  TEST_ASSERT_TRUE(stage.add(1, 255, px, sizeof(px)));
+  TEST_ASSERT_FALSE(stage.add(2, 255, px, sizeof(px)));
+  TEST_ASSERT_FALSE(stage.add(3, 255, nullptr, 0)); //not even a repeat fits
+  TEST_ASSERT_EQUAL(2, stage.dropped);
+  TEST_ASSERT_EQUAL(2 * frame, stage.len);
+
+  uint32_t written = 0;
+  TEST_ASSERT_EQUAL(2 * frame, stage.flush([&written](const uint8_t* d, uint32_t l) { written += l; return l; }));
+  TEST_ASSERT_EQUAL(2 * frame, written);
+  TEST_ASSERT_TRUE(stage.add(4, 255, px, sizeof(px)));
+  TEST_ASSERT_EQUAL(0, stage.flush([](const uint8_t* d, uint32_t l) { return (uint32_t)0; })); //write failed, data is gone
+  TEST_ASSERT_EQUAL(0, stage.len);
+  stage.end();
+  TEST_ASSERT_FALSE(stage.add(5, 255, nullptr, 0)); //ended, no buffer
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_file_layout);
+  RUN_TEST(test_full_stage_drops);
+  return UNITY_END();
+}
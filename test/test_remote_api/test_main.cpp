@@ -0,0 +1,153 @@
+/*
+ * JSON API over UDP and MQTT (util.cpp applyRemoteJSON()): rate limit, latest message kept over the limit,
+ * and parsing in the persistent arena
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include "src/dependencies/json/ArduinoJson-v6.h"
+#include "const.h"
+#include "api_helpers.h"
+
+//messages as sent by home automation, Node-RED and other WLED instances
+static const char* remoteMessages[] = {
+  "{\"on\":true,\"bri\":128}",
+  "{\"on\":\"t\",\"transition\":7}",
+  "{\"ps\":3}",
+  "{\"seg\":[{\"id\":0,\"col\":[[255,160,0],[0,0,0],[0,0,0]],\"fx\":9,\"sx\":128,\"ix\":200}]}",
+  "{\"seg\":[{\"id\":0,\"on\":true,\"bri\":255},{\"id\":1,\"on\":false},{\"id\":2,\"pal\":11,\"fx\":65}],\"mainseg\":0}",
+  "{\"nl\":{\"on\":true,\"dur\":30,\"mode\":1,\"tbri\":0},\"udpn\":{\"send\":false}}",
+  nullptr
+};
+
+//a copy like deferRemoteAPI() makes
+static char* copyOf(const char* msg) {
+  char* c = (char*)malloc(strlen(msg) + 1);
+  strcpy(c, msg);
+  return c;
+}
+
+static void test_burst_then_limit() {
+  RemoteQueue q(REMOTE_API_RATE, REMOTE_API_BURST);
+  for (uint8_t i = 0; i < REMOTE_API_BURST; i++) TEST_ASSERT_TRUE(q.allow(0));
+  TEST_ASSERT_FALSE(q.allow(0)); //burst used up
+  TEST_ASSERT_FALSE(q.allow(1000 / REMOTE_API_RATE / 2));
+  TEST_ASSERT_TRUE(q.allow(1000 / REMOTE_API_RATE)); //one message per 1000/REMOTE_API_RATE ms
+  TEST_ASSERT_FALSE(q.allow(1000 / REMOTE_API_RATE + 10));
+}
+
+static void test_sustained_rate() {
+  RemoteQueue q(REMOTE_API_RATE, REMOTE_API_BURST);
+  uint32_t handled = 0;
+  for (uint32_t ms = 0; ms < 10000; ms++) if (q.allow(ms)) handled++; //1000 messages/s offered
+  TEST_ASSERT_UINT32_WITHIN(2, REMOTE_API_RATE * 10 + REMOTE_API_BURST, handled);
+
+  TokenBucket idle(REMOTE_API_RATE, REMOTE_API_BURST);
+  for (uint8_t i = 0; i < REMOTE_API_BURST; i++) idle.take(0);
+  uint8_t n = 0;
+  while (idle.take(600000)) n++; //a long pause refills no more than one burst
+  TEST_ASSERT_EQUAL(REMOTE_API_BURST, n);
+}
+
+//millis() wraps after 49 days
+static void test_clock_wrap() {
+  TokenBucket b(REMOTE_API_RATE, REMOTE_API_BURST);
+  uint32_t t = 0xFFFFFF00UL;
+  while (b.take(t)) ;
+  TEST_ASSERT_TRUE(b.take(t + 0x100 + 1000 / REMOTE_API_RATE)); //across the wrap
+}
+
+//over the limit the latest message replaces the kept one and is handed out in order, once allowed
+static void test_latest_message_kept() {
+  RemoteQueue q(REMOTE_API_RATE, REMOTE_API_BURST);
+  while (q.allow(0)) ;
+  TEST_ASSERT_NULL(q.defer(copyOf("{\"bri\":10}"), 10, false));
+  char* old = q.defer(copyOf("A=20"), 4, true);
+  TEST_ASSERT_EQUAL_STRING("{\"bri\":10}", old); //dropped
+  free(old);
+  TEST_ASSERT_EQUAL(1, q.limited);
+
+  size_t len = 0;
+  bool set = false;
+  TEST_ASSERT_NULL(q.next(1, len, set)); //not allowed yet
+  TEST_ASSERT_FALSE(q.allow(1000)); //a new message waits behind the kept one
+  char* msg = q.next(1000, len, set);
+  TEST_ASSERT_EQUAL_STRING("A=20", msg);
+  TEST_ASSERT_EQUAL(4, len);
+  TEST_ASSERT_TRUE(set);
+  free(msg);
+  TEST_ASSERT_NULL(q.pending);
+  TEST_ASSERT_TRUE(q.allow(1000));
+
+  q.defer(nullptr, 10, false); //out of memory
+  TEST_ASSERT_EQUAL(2, q.limited);
+  TEST_ASSERT_TRUE(q.allow(2000));
+}
+
+//every sample message is applied from the arena, JSON and MessagePack, a larger one is left to the JSON pool
+static void test_arena_fits() {
+  DynamicJsonDocument arena(REMOTE_JSON_SIZE);
+  uint8_t applied = 0, n = 0;
+  auto apply = [&applied](JsonObject root) { if (root.size()) applied++; };
+  static uint8_t mp[512];
+  for (const char** m = remoteMessages; *m; m++, n++) {
+    TEST_ASSERT_TRUE(parseRemoteDoc(arena, *m, strlen(*m), apply) == DeserializationError::Ok);
+    size_t len = serializeMsgPack(arena, mp, sizeof(mp));
+    arena.clear();
+    TEST_ASSERT_TRUE(parseRemoteDoc(arena, (const char*)mp, len, apply) == DeserializationError::Ok);
+    arena.clear();
+  }
+  TEST_ASSERT_EQUAL(2 * n, applied);
+
+  std::string big = "{\"seg\":[";
+  for (uint8_t i = 0; i < 64; i++) {
+    if (i) big += ",";
+    big += "{\"id\":" + std::to_string(i) + ",\"col\":[[255,160,0],[0,0,0],[0,0,0]],\"fx\":9}";
+  }
+  big += "]}";
+  TEST_ASSERT_TRUE(parseRemoteDoc(arena, big.c_str(), big.length(), apply) == DeserializationError::NoMemory);
+  TEST_ASSERT_TRUE(parseRemoteDoc(arena, "[1,2]", 5, apply) == DeserializationError::InvalidInput);
+  TEST_ASSERT_EQUAL(2 * n, applied);
+}
+
+//messages/s parsed into the kept arena and into a new document per message (host timing, relative only)
+static void test_parse_throughput() {
+  const int runs = 20000;
+  DynamicJsonDocument arena(REMOTE_JSON_SIZE);
+  uint32_t applied = 0, n = 0;
+  auto apply = [&applied](JsonObject root) { applied++; };
+
+  typedef std::chrono::steady_clock clk;
+  clk::time_point t0 = clk::now();
+  for (int r = 0; r < runs; r++) {
+    for (const char** m = remoteMessages; *m; m++, n++) {
+      parseRemoteDoc(arena, *m, strlen(*m), apply);
+      arena.clear();
+    }
+  }
+  clk::time_point t1 = clk::now();
+  for (int r = 0; r < runs; r++) {
+    for (const char** m = remoteMessages; *m; m++) {
+      DynamicJsonDocument doc(REMOTE_JSON_SIZE);
+      parseRemoteDoc(doc, *m, strlen(*m), apply);
+    }
+  }
+  clk::time_point t2 = clk::now();
+
+  printf("%u sample messages: arena %.0f msg/s, document per message %.0f msg/s\n", (unsigned)(n / runs),
+    n / std::chrono::duration<double>(t1 - t0).count(), n / std::chrono::duration<double>(t2 - t1).count());
+  TEST_ASSERT_EQUAL(2 * n, applied);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_burst_then_limit);
+  RUN_TEST(test_sustained_rate);
+  RUN_TEST(test_clock_wrap);
+  RUN_TEST(test_latest_message_kept);
+  RUN_TEST(test_arena_fits);
+  RUN_TEST(test_parse_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,136 @@
+/*
+ * HTTP API tokenizer of handleSet(): keys, flags, relative values and requests/s
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "api_helpers.h"
+
+//requests as sent by the UI, home automation and the remote/button integrations
+static const char* apiRequests[] = {
+  "win&T=2",
+  "win&A=128",
+  "win&A=~10&FX=~&SX=~-16",
+  "win&R=255&G=160&B=0&W=0&R2=0&G2=0&B2=255",
+  "win&SM=1&SS=1&SV=2&S=10&S2=40&GP=1&SP=0&RV=1&MI=0&SB=200",
+  "win&FX=9&SX=128&IX=200&FP=11&TT=700&NL=10&NT=0&NF=1",
+  "win&PL=~&P1=1&P2=5&RB&SC&IN",
+  "win&CL=hFF00AA&C2=h00FF00&C3=h0000FF&HU=21845&SA=255&H2",
+  nullptr
+};
+
+static void test_values() {
+  const char* v[SK_COUNT];
+  tokenizeSet("win&A=128&FX=9&S2=40&S=10&CL=hFF00AA", v);
+  TEST_ASSERT_EQUAL_STRING("128&FX=9&S2=40&S=10&CL=hFF00AA", v[SK_A]);
+  TEST_ASSERT_EQUAL(128, atoi(v[SK_A]));
+  TEST_ASSERT_EQUAL(9, atoi(v[SK_FX]));
+  TEST_ASSERT_EQUAL(40, atoi(v[SK_S2]));
+  TEST_ASSERT_EQUAL(10, atoi(v[SK_S]));  //"S" is not confused with "S2" or "SX"
+  TEST_ASSERT_EQUAL('h', v[SK_CL][0]);
+  TEST_ASSERT_NULL(v[SK_SX]);
+  TEST_ASSERT_NULL(v[SK_T]);
+  TEST_ASSERT_NULL(v[SK_R]);
+}
+
+static void test_flags() {
+  const char* v[SK_COUNT];
+  tokenizeSet("win&RB&SR=1&H2&T=2", v);
+  TEST_ASSERT_NOT_NULL(v[SK_RB]); //flag without value
+  TEST_ASSERT_EQUAL('&', v[SK_RB][0]);
+  TEST_ASSERT_EQUAL(1, atoi(v[SK_SR]));
+  TEST_ASSERT_NOT_NULL(v[SK_H2]);
+  TEST_ASSERT_EQUAL(2, atoi(v[SK_T]));
+
+  tokenizeSet("win&SC", v); //flag at the end of the request
+  TEST_ASSERT_NOT_NULL(v[SK_SC]);
+  TEST_ASSERT_EQUAL('\0', v[SK_SC][0]);
+
+  tokenizeSet("win&A&T", v); //keys that need a value are ignored without one
+  TEST_ASSERT_NULL(v[SK_A]);
+  TEST_ASSERT_NULL(v[SK_T]);
+}
+
+static void test_relative_values() {
+  const char* v[SK_COUNT];
+  tokenizeSet("win&A=~10&FX=~&SX=~-&IX=~-300&PL=~0", v);
+  TEST_ASSERT_EQUAL('~', v[SK_A][0]);
+  TEST_ASSERT_EQUAL(138, stepValue(v[SK_A] + 1, 128, 0, 255, false));
+  TEST_ASSERT_EQUAL(255, stepValue(v[SK_A] + 1, 250, 0, 255, false)); //stops at the limit
+  TEST_ASSERT_EQUAL(0,   stepValue(v[SK_A] + 1, 255, 0, 255, true));  //or wraps
+  TEST_ASSERT_EQUAL(10,  stepValue(v[SK_FX] + 1, 9, 0, 117, false));
+  TEST_ASSERT_EQUAL(0,   stepValue(v[SK_FX] + 1, 117, 0, 117, false)); //"~" always wraps
+  TEST_ASSERT_EQUAL(127, stepValue(v[SK_SX] + 1, 128, 0, 255, false));
+  TEST_ASSERT_EQUAL(255, stepValue(v[SK_SX] + 1, 0, 0, 255, false));
+  TEST_ASSERT_EQUAL(0,   stepValue(v[SK_IX] + 1, 200, 0, 255, false));
+  TEST_ASSERT_EQUAL(3,   stepValue(v[SK_PL] + 1, 3, 1, 5, false));     //"~0" keeps the value
+}
+
+static void test_duplicate_keys() {
+  const char* v[SK_COUNT];
+  tokenizeSet("win&A=10&A=20&FX=1&T=0&FX=2", v);
+  TEST_ASSERT_EQUAL(10, atoi(v[SK_A])); //the first occurrence wins
+  TEST_ASSERT_EQUAL(1, atoi(v[SK_FX]));
+  TEST_ASSERT_EQUAL(0, atoi(v[SK_T]));
+}
+
+static void test_unknown_keys() {
+  const char* v[SK_COUNT];
+  tokenizeSet("win&XY=5&ABC=1&=3&&A=7&FXX=2&Z&T=1", v);
+  TEST_ASSERT_EQUAL(7, atoi(v[SK_A]));
+  TEST_ASSERT_EQUAL(1, atoi(v[SK_T]));
+  TEST_ASSERT_NULL(v[SK_FX]); //"FXX" is not "FX"
+  uint8_t found = 0;
+  for (uint8_t i = 0; i < SK_COUNT; i++) if (v[i]) found++;
+  TEST_ASSERT_EQUAL(2, found);
+
+  tokenizeSet("win", v);
+  for (uint8_t i = 0; i < SK_COUNT; i++) TEST_ASSERT_NULL(v[i]);
+}
+
+//former lookup: one scan of the whole request for each key
+static uint8_t scanPerKey(const char* req) {
+  static const char* keys[] = {
+    "SM=","SS=","SV=","S=","S2=","GP=","SP=","RV=","MI=","SB=","SW=","PS=","P1=","P2=","PL=","A=",
+    "R=","G=","B=","W=","R2=","G2=","B2=","W2=","LX=","LY=","HU=","SA=","K=","CL=","C2=","C3=",
+    "FX=","SX=","IX=","FP=","OL=","M=","SN=","RN=","RD=","T=","NL=","NT=","NF=","TT=","ST=","CT=",
+    "LO=","NM=","U0=","U1=","H2","K2","SR","SC","ND","RB","NN","IN"
+  };
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) if (strstr(req, keys[i])) n++;
+  return n;
+}
+
+//requests/s of both lookups over the sample requests (host timing, relative only)
+static void test_requests_per_second() {
+  const int runs = 20000;
+  const char* v[SK_COUNT];
+  uint32_t n = 0;
+  volatile uint32_t sink = 0;
+  typedef std::chrono::steady_clock clk;
+  clk::time_point t0 = clk::now();
+  for (int r = 0; r < runs; r++) {
+    for (const char** req = apiRequests; *req; req++, n++) { tokenizeSet(*req, v); sink += v[SK_A] != nullptr; }
+  }
+  clk::time_point t1 = clk::now();
+  for (int r = 0; r < runs; r++) {
+    for (const char** req = apiRequests; *req; req++) sink += scanPerKey(*req);
+  }
+  clk::time_point t2 = clk::now();
+
+  printf("%u sample requests: tokenizer %.0f req/s, scan per key %.0f req/s\n", (unsigned)(n / runs),
+    n / std::chrono::duration<double>(t1 - t0).count(), n / std::chrono::duration<double>(t2 - t1).count());
+  TEST_ASSERT_TRUE(t1 - t0 < t2 - t1);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_values);
+  RUN_TEST(test_flags);
+  RUN_TEST(test_relative_values);
+  RUN_TEST(test_duplicate_keys);
+  RUN_TEST(test_unknown_keys);
+  RUN_TEST(test_requests_per_second);
+  return UNITY_END();
+}
@@ -0,0 +1,126 @@
+/*
+ * Replays a DNRGB stream through the UDP receive loop of handleNotifications(): drainPackets() with the
+ * default budget, each packet decoded by decodeUdpRealtime() like handleUdpPacket() does
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "const.h"
+#include "api_helpers.h"
+
+#define LEDS 1200
+#define LEDS_PER_PACKET 489 //largest DNRGB packet of one 1472 byte datagram, as sent by xLights and LedFx
+#define PACKETS_PER_FRAME ((LEDS + LEDS_PER_PACKET - 1) / LEDS_PER_PACKET)
+
+static uint32_t clockMs;    //simulated millis()
+static uint16_t costMs;     //time handling a packet takes
+static uint16_t senderFps;  //frames sent per second, PACKETS_PER_FRAME datagrams each at the frame time
+static uint32_t nextPkt;    //first packet not yet handled
+static uint32_t frames;     //frames whose last packet was handled
+static uint8_t  pixels[LEDS * 3];
+static bool     torn;       //a completed frame had pixels of another frame
+static bool     overBudget; //a loop() pass handled more than its budget
+
+static uint32_t now() { return clockMs; }
+
+//datagram p of the stream, pixel bytes carry the frame number
+static uint16_t dnrgbPacket(uint32_t p, uint8_t* buf) {
+  uint32_t frame = p / PACKETS_PER_FRAME;
+  uint16_t start = (p % PACKETS_PER_FRAME) * LEDS_PER_PACKET;
+  uint16_t n = (LEDS - start < LEDS_PER_PACKET) ? LEDS - start : LEDS_PER_PACKET;
+  buf[0] = 4; buf[1] = 2; buf[2] = start >> 8; buf[3] = start;
+  memset(buf + 4, frame & 0xFF, n * 3);
+  return 4 + n * 3;
+}
+
+//one pending datagram, as handleUdpPacket()
+static bool handle() {
+  if ((nextPkt / PACKETS_PER_FRAME) * 1000 / senderFps > clockMs) return false; //not sent yet
+  static uint8_t udpIn[1472];
+  uint16_t len = dnrgbPacket(nextPkt++, udpIn);
+  UdpRealtimeSpan span;
+  if (!decodeUdpRealtime(udpIn, len, span) || span.stride != 3) return true;
+  memcpy(pixels + span.start * 3, span.data, span.count * 3);
+  if (span.start + span.count == LEDS) {
+    frames++;
+    for (uint16_t i = 0; i < sizeof(pixels); i++) if (pixels[i] != pixels[0]) torn = true;
+  }
+  clockMs += costMs;
+  return true;
+}
+
+void setUp() {
+  clockMs = 0; costMs = 0; senderFps = 40; nextPkt = 0; frames = 0; torn = false; overBudget = false;
+}
+
+//complete frames per second over 10 s with a loop() pass every passMs
+static uint32_t replay(uint16_t passMs) {
+  uint32_t pass = 0;
+  while (clockMs < 10000) {
+    uint32_t t0 = clockMs;
+    uint8_t n = drainPackets(handle, now, UDP_MAX_PACKETS_PER_LOOP, UDP_MAX_MS_PER_LOOP);
+    if (n > UDP_MAX_PACKETS_PER_LOOP) overBudget = true;
+    if (n > 1 && clockMs - t0 >= (uint32_t)UDP_MAX_MS_PER_LOOP + costMs) overBudget = true; //only the last packet may overrun the time
+    clockMs = ++pass * passMs;
+  }
+  return frames / 10;
+}
+
+static void test_decode() {
+  uint8_t buf[8] = {4, 2, 0x01, 0x02, 10, 20, 30, 40};
+  UdpRealtimeSpan s;
+  TEST_ASSERT_TRUE(decodeUdpRealtime(buf, 8, s));
+  TEST_ASSERT_EQUAL(258, s.start);
+  TEST_ASSERT_EQUAL(1, s.count); //partial pixel ignored
+  TEST_ASSERT_EQUAL(10, s.data[0]);
+  buf[0] = 3;
+  TEST_ASSERT_TRUE(decodeUdpRealtime(buf, 8, s));
+  TEST_ASSERT_EQUAL(0, s.start);
+  TEST_ASSERT_EQUAL(1, s.count);
+  TEST_ASSERT_EQUAL(4, s.stride);
+  buf[0] = 4;
+  TEST_ASSERT_FALSE(decodeUdpRealtime(buf, 3, s)); //start index cut off
+  buf[0] = 1;
+  TEST_ASSERT_FALSE(decodeUdpRealtime(buf, 8, s)); //WARLS
+}
+
+static void test_empty_queue() {
+  nextPkt = 1000; //first packet due in the future
+  TEST_ASSERT_EQUAL_UINT8(0, drainPackets(handle, now, UDP_MAX_PACKETS_PER_LOOP, UDP_MAX_MS_PER_LOOP));
+}
+
+//a typical stream is handled completely at a 20 ms loop() pass
+static void test_replay_keeps_up() {
+  TEST_ASSERT_EQUAL(40, replay(20));
+  TEST_ASSERT_FALSE(torn);
+  TEST_ASSERT_FALSE(overBudget);
+}
+
+//frames/s at the ingest limit: a fast sender and a slow loop() pass (long show() of many LEDs)
+static void test_replay_ingest_limit() {
+  senderFps = 250;
+  uint32_t fps = replay(30);
+  printf("%u LEDs in %u packets, loop() every 30 ms: %u of %u frames/s\n",
+    LEDS, PACKETS_PER_FRAME, (unsigned)fps, senderFps);
+  TEST_ASSERT_UINT32_WITHIN(1, 1000 / 30 * UDP_MAX_PACKETS_PER_LOOP / PACKETS_PER_FRAME, fps); //packet limit
+  TEST_ASSERT_FALSE(torn);
+  TEST_ASSERT_FALSE(overBudget);
+}
+
+//a slow handler is limited by the time budget instead, the backlog carries over to the following passes
+static void test_replay_time_budget() {
+  senderFps = 250; costMs = 1;
+  uint32_t fps = replay(30);
+  TEST_ASSERT_UINT32_WITHIN(1, 1000 / 30 * UDP_MAX_MS_PER_LOOP / PACKETS_PER_FRAME, fps);
+  TEST_ASSERT_FALSE(overBudget);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_decode);
+  RUN_TEST(test_empty_queue);
+  RUN_TEST(test_replay_keeps_up);
+  RUN_TEST(test_replay_ingest_limit);
+  RUN_TEST(test_replay_time_budget);
+  return UNITY_END();
+}
@@ -41,6 +41,7 @@ function hexdump(buffer) {
 }
 
 const inliner = require("inliner");
+const palettes = require("./palettes");
 const zlib = require("zlib");
 
 function strReplace(str, search, replacement) {
@@ -195,6 +196,7 @@ function writeChunks(srcDir, specs, resultFile) {
 }
 
 writeHtmlGzipped("wled00/data/index.htm", "wled00/html_ui.h");
+palettes.writePalettePreviews("wled00/palettes.h", "wled00/html_palx.h");
 
 writeChunks(
   "wled00/data",
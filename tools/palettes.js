@@ -0,0 +1,112 @@
+/**
+ * Writes the palette previews of /json/palx as a compressed C array (wled00/html_palx.h)
+ *
+ * Called by cdata.js, or on its own without any npm packages:
+ *
+ * > node tools/palettes.js
+ *
+ * The previews are read from the gradient palettes in wled00/palettes.h.
+ * Palettes 0-12 are FastLED's built-in palettes and the ones made from the segment colors.
+ */
+
+const fs = require("fs");
+const zlib = require("zlib");
+
+// FastLED colorpalettes.cpp, 16 colors each
+const fastledPalettes = {
+  Party: [0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+          0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9],
+  Cloud: [0x0000FF, 0x00008B, 0x00008B, 0x00008B, 0x00008B, 0x00008B, 0x00008B, 0x00008B,
+          0x0000FF, 0x00008B, 0x87CEEB, 0x87CEEB, 0xADD8E6, 0xFFFFFF, 0xADD8E6, 0x87CEEB],
+  Lava: [0x000000, 0x800000, 0x000000, 0x800000, 0x8B0000, 0x8B0000, 0x800000, 0x8B0000,
+         0x8B0000, 0x8B0000, 0xFF0000, 0xFFA500, 0xFFFFFF, 0xFFA500, 0xFF0000, 0x8B0000],
+  Ocean: [0x191970, 0x00008B, 0x191970, 0x000080, 0x00008B, 0x0000CD, 0x2E8B57, 0x008080,
+          0x5F9EA0, 0x0000FF, 0x008B8B, 0x6495ED, 0x7FFFD4, 0x2E8B57, 0x00FFFF, 0x87CEFA],
+  Forest: [0x006400, 0x006400, 0x556B2F, 0x006400, 0x008000, 0x228B22, 0x6B8E23, 0x008000,
+           0x2E8B57, 0x66CDAA, 0x32CD32, 0x9ACD32, 0x90EE90, 0x7CFC00, 0x66CDAA, 0x228B22],
+  Rainbow: [0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+            0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B],
+  RainbowStripe: [0xFF0000, 0x000000, 0xAB5500, 0x000000, 0xABAB00, 0x000000, 0x00FF00, 0x000000,
+                  0x00AB55, 0x000000, 0x0000FF, 0x000000, 0x5500AB, 0x000000, 0xAB0055, 0x000000]
+};
+
+function hexdump(buffer) {
+  let lines = [];
+  for (let i = 0; i < buffer.length; i += 16) {
+    let hexArray = [];
+    for (let value of buffer.slice(i, i + 16)) hexArray.push("0x" + value.toString(16).padStart(2, "0"));
+    lines.push("  " + hexArray.join(", "));
+  }
+  return lines.join(",\n");
+}
+
+function fastledPreview(colors) {
+  return colors.map((c, i) => [i << 4, (c >> 16) & 255, (c >> 8) & 255, c & 255]);
+}
+
+// [index,r,g,b] entries of each gradient palette, in the order of gGradientPalettes[]
+function gradientPreviews(src) {
+  let tables = {};
+  for (let m of src.matchAll(/const\s+byte\s+(\w+)\[\]\s+PROGMEM\s*=\s*\{([^}]*)\}/g)) {
+    let bytes = m[2].split(",").map(s => s.trim()).filter(s => s.length).map(Number);
+    let entries = [];
+    for (let i = 0; i + 3 < bytes.length && entries.length < 18; i += 4) { // json.cpp reads 72 bytes at most
+      entries.push(bytes.slice(i, i + 4));
+      if (bytes[i] == 255) break;
+    }
+    tables[m[1]] = entries;
+  }
+  let list = src.match(/gGradientPalettes\[\]\s+PROGMEM\s*=\s*\{([^}]*)\}/)[1];
+  return list.replace(/\/\/.*$/gm, "").split(",").map(s => s.trim()).filter(s => s.length).map(name => {
+    if (!tables[name]) throw new Error("Gradient palette " + name + " not found");
+    return tables[name];
+  });
+}
+
+// same text as the fallback that streams them in json.cpp
+function palettePreviews(palettesFile) {
+  let previews = [
+    fastledPreview(fastledPalettes.Party), // default
+    ["r", "r", "r", "r"],                  // random
+    ["c1"],
+    ["c1", "c1", "c2", "c2"],
+    ["c3", "c2", "c1"],
+    ["c1", "c1", "c1", "c1", "c1", "c2", "c2", "c2", "c2", "c2", "c3", "c3", "c3", "c3", "c3", "c1"],
+    fastledPreview(fastledPalettes.Party),
+    fastledPreview(fastledPalettes.Cloud),
+    fastledPreview(fastledPalettes.Lava),
+    fastledPreview(fastledPalettes.Ocean),
+    fastledPreview(fastledPalettes.Forest),
+    fastledPreview(fastledPalettes.Rainbow),
+    fastledPreview(fastledPalettes.RainbowStripe)
+  ].concat(gradientPreviews(fs.readFileSync(palettesFile, "utf8")));
+
+  let p = {};
+  previews.forEach((prev, i) => p[i] = prev);
+  return { count: previews.length, json: JSON.stringify({ m: 0, p: p }) };
+}
+
+function writePalettePreviews(palettesFile, resultFile) {
+  let previews = palettePreviews(palettesFile);
+  let result = zlib.gzipSync(previews.json, { level: zlib.constants.Z_BEST_COMPRESSION });
+  console.info("Palette previews: " + previews.count + " palettes, " + previews.json.length + " characters, compressed " + result.length + " bytes");
+  const src = `/*
+ * Palette previews of /json/palx, gzip compressed.
+ */
+
+// Autogenerated from ${palettesFile} by tools/palettes.js, do not edit!!
+#define JSON_PALX_COUNT ${previews.count}
+const uint16_t JSON_palx_L = ${result.length};
+const uint8_t JSON_palx[] PROGMEM = {
+${hexdump(result)}
+};
+`;
+  console.info("Writing " + resultFile);
+  fs.writeFileSync(resultFile, src);
+}
+
+module.exports = { writePalettePreviews };
+
+if (require.main === module) {
+  writePalettePreviews("wled00/palettes.h", "wled00/html_palx.h");
+}
@@ -620,7 +620,7 @@ class WS2812FX {
     }
 
     void
-      finalizeInit(),
+      finalizeInit(bool resetRuntimes = true),
       service(void),
       blur(uint8_t),
       fill(uint32_t),
@@ -643,6 +643,8 @@ class WS2812FX {
       makeAutoSegments(bool forceReset = false),
       fixInvalidSegments(),
       setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0),
+      fillSpan(uint16_t i, uint16_t n, uint32_t c),
+      writeSpan(uint16_t i, const uint8_t* rgb, uint16_t n, uint8_t stride, const uint8_t* lut = nullptr),
       show(void),
 			setTargetFps(uint8_t fps),
       deserializeMap(uint8_t n=0);
@@ -713,6 +715,9 @@ class WS2812FX {
     WS2812FX::Segment*
       getSegments(void);
 
+    const uint8_t*
+      getGammaTable(void);
+
     // builtin modes
     uint16_t
       mode_static(void),
@@ -884,6 +889,8 @@ class WS2812FX {
     CRGB twinklefox_one_twinkle(uint32_t ms, uint8_t salt, bool cat);
     CRGB pacifica_one_layer(uint16_t i, CRGBPalette16& p, uint16_t cistart, uint16_t wavescale, uint8_t bri, uint16_t ioff);
 
+    bool getPhysicalSpan(uint16_t i, uint16_t n, uint16_t& first, bool& reversed);
+
     void
       blendPixelColor(uint16_t n, uint32_t color, uint8_t blend),
       startTransition(uint8_t oldBri, uint32_t oldCol, uint16_t dur, uint8_t segn, uint8_t slot),
@@ -70,10 +70,11 @@
 #endif
 
 //do not call this method from system context (network callback)
-void WS2812FX::finalizeInit(void)
+void WS2812FX::finalizeInit(bool resetRuntimes)
 {
-  //reset segment runtimes
-  for (uint8_t i = 0; i < MAX_NUM_SEGMENTS; i++) {
+  stateGeneration++; infoGeneration++; //LED count and segments may change
+  //reset segment runtimes (segments whose bounds change are reset in setSegment() anyway)
+  if (resetRuntimes) for (uint8_t i = 0; i < MAX_NUM_SEGMENTS; i++) {
     _segment_runtimes[i].markForReset();
     _segment_runtimes[i].resetIfRequired();
   }
@@ -129,6 +130,13 @@ void WS2812FX::service() {
   if (nowUp - _lastShow < MIN_SHOW_DELAY) return;
   bool doShow = false;
 
+  //interpolated realtime frame at the target FPS (the live segment is frozen, effects keep running elsewhere)
+  if (realtimeMode && rtInterpolate && nowUp - _lastShow >= FRAMETIME) doShow = renderRealtimeFrame();
+  if (realtimeMode && !realtimeOverride && !useMainSegmentOnly && !realtimeRoutesActive()) {
+    if (doShow) show();
+    return;
+  }
+
   for(uint8_t i=0; i < MAX_NUM_SEGMENTS; i++)
   {
     //if (realtimeMode && useMainSegmentOnly && i == getMainSegmentId()) continue;
@@ -247,6 +255,62 @@ void IRAM_ATTR WS2812FX::setPixelColor(uint16_t i, byte r, byte g, byte b, byte
 }
 
 
+/*
+ * Maps pixels i to i+n-1 of the current segment (or of the strip in realtime mode) to a run of physical pixels.
+ * Returns false if they are not contiguous (grouping/spacing, mirror, offset wrap-around or ledmap),
+ * in which case the caller has to fall back to setPixelColor().
+ */
+bool WS2812FX::getPhysicalSpan(uint16_t i, uint16_t n, uint16_t& first, bool& reversed)
+{
+  if (!n || customMappingSize) return false;
+  reversed = false;
+  if (SEGLEN || (realtimeMode && useMainSegmentOnly)) {
+    Segment& seg = _segments[SEGLEN ? _segment_index : _mainSegment];
+    uint16_t len = seg.length();
+    if (seg.groupLength() != 1 || (seg.options & MIRROR) || seg.offset >= len || (uint32_t)i + n > len) return false;
+    reversed = seg.options & REVERSE;
+    uint16_t lo = (reversed ? len - i - n : i) + seg.offset; //lowest segment relative index of the span
+    uint16_t hi = lo + n - 1;
+    if (lo < len && hi >= len) return false; //wraps around due to offset
+    first = seg.start + (lo >= len ? lo - len : lo);
+  } else {
+    first = i;
+  }
+  return true;
+}
+
+/*
+ * Sets n pixels to one color, resolving segment geometry and bus routing once for the whole span.
+ */
+void WS2812FX::fillSpan(uint16_t i, uint16_t n, uint32_t c)
+{
+  uint16_t first; bool reversed;
+  if (!getPhysicalSpan(i, n, first, reversed)) {
+    for (uint16_t x = 0; x < n; x++) setPixelColor(i + x, c);
+    return;
+  }
+  if (SEGLEN && _bri_t < 255) c = RGBW32(scale8(R(c), _bri_t), scale8(G(c), _bri_t), scale8(B(c), _bri_t), scale8(W(c), _bri_t));
+  busses.fillPixels(first, n, c);
+}
+
+/*
+ * Sets n pixels from a byte buffer, stride 3 for RGB or 4 for RGBW data.
+ * If given, lut (e.g. getGammaTable()) is applied to every channel on the way into the bus buffers.
+ */
+void WS2812FX::writeSpan(uint16_t i, const uint8_t* rgb, uint16_t n, uint8_t stride, const uint8_t* lut)
+{
+  uint16_t first; bool reversed;
+  if ((SEGLEN && _bri_t < 255) || stride < 3 || !getPhysicalSpan(i, n, first, reversed)) {
+    for (uint16_t x = 0; x < n; x++, rgb += stride) {
+      if (lut) setPixelColor(i + x, lut[rgb[0]], lut[rgb[1]], lut[rgb[2]], stride > 3 ? lut[rgb[3]] : 0);
+      else     setPixelColor(i + x, rgb[0], rgb[1], rgb[2], stride > 3 ? rgb[3] : 0);
+    }
+    return;
+  }
+  if (reversed) busses.writePixels(first, rgb + (n - 1) * stride, n, -(int8_t)stride, lut);
+  else          busses.writePixels(first, rgb, n, stride, lut);
+}
+
 //DISCLAIMER
 //The following function attemps to calculate the current LED power usage,
 //and will limit the brightness to stay below a set amperage threshold.
@@ -431,6 +495,7 @@ void WS2812FX::setCCT(uint16_t k) {
 }
 
 void WS2812FX::setBrightness(uint8_t b, bool direct) {
+  Bus::setGammaBri(gammaCorrectBri ? b : 0); //PWM busses apply the curve at their full resolution
   if (gammaCorrectBri) b = gamma8(b);
   if (_brightness == b) return;
   _brightness = b;
@@ -811,10 +876,10 @@ void WS2812FX::setRange(uint16_t i, uint16_t i2, uint32_t col)
 {
   if (i2 >= i)
   {
-    for (uint16_t x = i; x <= i2; x++) setPixelColor(x, col);
+    fillSpan(i, i2 - i + 1, col);
   } else
   {
-    for (uint16_t x = i2; x <= i; x++) setPixelColor(x, col);
+    fillSpan(i2, i - i2 + 1, col);
   }
 }
 
@@ -871,9 +936,7 @@ uint32_t IRAM_ATTR WS2812FX::color_blend(uint32_t color1, uint32_t color2, uint1
  * Fills segment with color
  */
 void WS2812FX::fill(uint32_t c) {
-  for(uint16_t i = 0; i < SEGLEN; i++) {
-    setPixelColor(i, c);
-  }
+  fillSpan(0, SEGLEN, c);
 }
 
 /*
@@ -1181,14 +1244,16 @@ void WS2812FX::deserializeMap(uint8_t n) {
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(7)) return;
+  JsonDocument* pDoc = requestJSONBuffer(7);
+  if (!pDoc) return;
+  JsonDocument& doc = *pDoc;
   #endif
 
   DEBUG_PRINT(F("Reading LED map from "));
   DEBUG_PRINTLN(fileName);
 
   if (!readObjectFromFile(fileName, nullptr, &doc)) {
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
     return; //if file does not exist just exit
   }
 
@@ -1208,7 +1273,7 @@ void WS2812FX::deserializeMap(uint8_t n) {
     }
   }
 
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
 }
 
 //gamma 2.8 lookup table used for color correction
@@ -1246,6 +1311,11 @@ uint8_t WS2812FX::gamma8(uint8_t b)
   return gammaT[b];
 }
 
+const uint8_t* WS2812FX::getGammaTable()
+{
+  return gammaT;
+}
+
 uint32_t WS2812FX::gamma32(uint32_t color)
 {
   if (!gammaCorrectCol) return color;
@@ -1266,3 +1336,4 @@ WS2812FX* WS2812FX::instance = nullptr;
 int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0;
 uint8_t Bus::_autoWhiteMode = RGBW_MODE_DUAL;
+uint8_t Bus::_gammaBri = 0;
@@ -0,0 +1,298 @@
+#ifndef WLED_API_HELPERS_H
+#define WLED_API_HELPERS_H
+
+/*
+ * Helpers of the network APIs and the frame recorder that do not depend on the Arduino core.
+ * Also built for the host by the native unit tests in test/ (pio test -e native).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifndef PROGMEM //host build
+  #define PROGMEM
+#endif
+#ifndef pgm_read_word
+  #define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#endif
+
+//handles pending packets until none is left or the budget of this loop() pass is used up, returns packets handled
+//handle() returns false if no packet was pending, now() returns a millisecond clock
+template <typename H, typename C>
+uint8_t drainPackets(H handle, C now, uint8_t maxPackets, uint16_t maxMs)
+{
+  uint32_t start = now();
+  uint8_t n = 0;
+  while (n < maxPackets) {
+    if (!handle()) break;
+    n++;
+    if ((uint32_t)(now() - start) >= maxMs) break;
+  }
+  return n;
+}
+
+//pixels of a UDP realtime packet: in[0] type (2 DRGB, 3 DRGBW, 4 DNRGB, 5 DNRGBW), in[1] timeout,
+//DNRGB(W) continue with the start index (big endian). WARLS (1) sets single pixels and is not a span
+struct UdpRealtimeSpan
+{
+  uint16_t start, count;
+  uint8_t stride;
+  const uint8_t* data;
+};
+
+//false if the packet is no pixel span or too short
+inline bool decodeUdpRealtime(const uint8_t* in, uint16_t len, UdpRealtimeSpan& s)
+{
+  uint8_t hdr;
+  switch (len > 1 ? in[0] : 0) {
+    case 2: hdr = 2; s.stride = 3; break;
+    case 3: hdr = 2; s.stride = 4; break;
+    case 4: hdr = 4; s.stride = 3; break;
+    case 5: hdr = 4; s.stride = 4; break;
+    default: return false;
+  }
+  if (len < hdr) return false;
+  s.start = (hdr == 4) ? (in[2] << 8 | in[3]) : 0;
+  s.data  = in + hdr;
+  s.count = (len - hdr) / s.stride;
+  return true;
+}
+
+//rate limit of the UDP and MQTT APIs: rate messages per second on average, up to burst at once
+struct TokenBucket
+{
+  uint16_t rate, burst;
+  uint32_t tokens, last; //100 tokens per message
+  TokenBucket(uint16_t r, uint16_t b) : rate(r), burst(b), tokens(b * 100UL), last(0) {}
+
+  //true if a message may be handled at millisecond time now
+  bool take(uint32_t now)
+  {
+    uint32_t dt = now - last;
+    uint32_t add = (dt > 1000 ? 1000 : dt) * rate / 10;
+    if (add) {
+      last = now;
+      tokens = tokens + add > burst * 100UL ? burst * 100UL : tokens + add;
+    }
+    if (tokens < 100) return false;
+    tokens -= 100;
+    return true;
+  }
+};
+
+//API messages over the rate limit: the latest one is kept, replacing an older one, and handed out
+//once allowed again, so the final state of a burst is never lost. Callers lock it (util.cpp)
+struct RemoteQueue
+{
+  TokenBucket bucket;
+  char* pending = nullptr; //latest message over the limit, 0-terminated
+  size_t pendingLen = 0;
+  bool pendingSet = false; //HTTP API request instead of JSON
+  uint32_t limited = 0;    //messages dropped
+  RemoteQueue(uint16_t rate, uint16_t burst) : bucket(rate, burst) {}
+
+  //true if a message may be handled now, false while an older one waits so they stay in order
+  bool allow(uint32_t now) { return !pending && bucket.take(now); }
+
+  //keeps copy (malloc'd, nullptr if that failed) as the pending message, returns the older one to free
+  char* defer(char* copy, size_t len, bool set)
+  {
+    char* old = pending;
+    pending = copy;
+    pendingLen = copy ? len : 0;
+    pendingSet = set;
+    if (old || !copy) limited++;
+    return old;
+  }
+
+  //the pending message if allowed now (to free by the caller), else nullptr
+  char* next(uint32_t now, size_t& len, bool& set)
+  {
+    if (!pending || !bucket.take(now)) return nullptr;
+    char* msg = pending;
+    len = pendingLen; set = pendingSet;
+    pending = nullptr;
+    return msg;
+  }
+};
+
+//true if an Accept or Content-Type header value names MessagePack (application/msgpack, application/x-msgpack)
+inline bool isMsgPackMediaType(const char* value)
+{
+  return value && strstr(value, "msgpack");
+}
+
+//Content-Type of a JSON API reply
+inline const char* jsonContentType(bool msgpack)
+{
+  return msgpack ? "application/msgpack" : "application/json";
+}
+
+//true if a binary message is a MessagePack map (fixmap, map 16, map 32), i.e. a JSON API object
+inline bool isMsgPackMap(const uint8_t* data, size_t len)
+{
+  return len && ((data[0] & 0xF0) == 0x80 || data[0] == 0xDE || data[0] == 0xDF);
+}
+
+#ifdef ARDUINOJSON_VERSION
+//JSON text or a MessagePack map into doc, then apply(root) to the object.
+//Input is copied, not parsed in place, so it is still intact for a second try in another document
+template <typename A>
+DeserializationError parseRemoteDoc(JsonDocument& doc, const char* in, size_t len, A apply)
+{
+  DeserializationError error = isMsgPackMap((const uint8_t*)in, len) ? deserializeMsgPack(doc, in, len) : deserializeJson(doc, in, len);
+  JsonObject root = doc.as<JsonObject>();
+  if (!error && root.isNull()) error = DeserializationError::InvalidInput;
+  if (!error) apply(root);
+  return error;
+}
+
+//serializeSegment() writes "col" as raw JSON text, which serializeMsgPack() would copy verbatim.
+//Replaces it with nested arrays in the segments of a serialized state, false if the document is full
+inline bool expandSegmentColors(JsonObject state)
+{
+  for (JsonObject seg : state["seg"].as<JsonArray>()) {
+    JsonVariant col = seg["col"];
+    if (col.isNull() || col.is<JsonArray>()) continue;
+    char txt[72];
+    serializeJson(col, txt, sizeof(txt)); //the raw text
+    JsonArray cols = seg.createNestedArray("col");
+    JsonArray c;
+    if (cols.isNull()) return false;
+    for (char* p = txt + 1; *p; p++) {
+      if (*p == '[') c = cols.createNestedArray();
+      else if (*p >= '0' && *p <= '9') {
+        if (!c.add(strtoul(p, &p, 10))) return false;
+        p--;
+      }
+    }
+  }
+  return true;
+}
+#endif
+
+/*
+ * HTTP API keys, 1 or 2 characters packed into 16 bit (first character in the low byte).
+ * Keys from SK_FLAGS on are also accepted without a value (e.g. "&RB").
+ */
+#define SETKEY(a,b) ((uint16_t)(a) | ((uint16_t)(b) << 8))
+enum SetKey : uint8_t {
+  SK_SM, SK_SS, SK_SV, SK_S, SK_S2, SK_GP, SK_SP, SK_RV, SK_MI, SK_SB, SK_SW,
+  SK_PS, SK_P1, SK_P2, SK_PL, SK_A,
+  SK_R, SK_G, SK_B, SK_W, SK_R2, SK_G2, SK_B2, SK_W2, SK_LX, SK_LY,
+  SK_HU, SK_SA, SK_K, SK_CL, SK_C2, SK_C3,
+  SK_FX, SK_SX, SK_IX, SK_FP, SK_OL, SK_M, SK_SN, SK_RN, SK_RD,
+  SK_T, SK_NL, SK_NT, SK_NF, SK_TT, SK_ST, SK_CT, SK_LO, SK_NM, SK_U0, SK_U1,
+  SK_FLAGS,
+  SK_H2 = SK_FLAGS, SK_K2, SK_SR, SK_SC, SK_ND, SK_RB, SK_NN, SK_IN,
+  SK_COUNT
+};
+static const uint16_t setKeyCodes[SK_COUNT] PROGMEM = {
+  SETKEY('S','M'), SETKEY('S','S'), SETKEY('S','V'), SETKEY('S',0), SETKEY('S','2'), SETKEY('G','P'),
+  SETKEY('S','P'), SETKEY('R','V'), SETKEY('M','I'), SETKEY('S','B'), SETKEY('S','W'),
+  SETKEY('P','S'), SETKEY('P','1'), SETKEY('P','2'), SETKEY('P','L'), SETKEY('A',0),
+  SETKEY('R',0), SETKEY('G',0), SETKEY('B',0), SETKEY('W',0), SETKEY('R','2'), SETKEY('G','2'),
+  SETKEY('B','2'), SETKEY('W','2'), SETKEY('L','X'), SETKEY('L','Y'),
+  SETKEY('H','U'), SETKEY('S','A'), SETKEY('K',0), SETKEY('C','L'), SETKEY('C','2'), SETKEY('C','3'),
+  SETKEY('F','X'), SETKEY('S','X'), SETKEY('I','X'), SETKEY('F','P'), SETKEY('O','L'), SETKEY('M',0),
+  SETKEY('S','N'), SETKEY('R','N'), SETKEY('R','D'),
+  SETKEY('T',0), SETKEY('N','L'), SETKEY('N','T'), SETKEY('N','F'), SETKEY('T','T'), SETKEY('S','T'),
+  SETKEY('C','T'), SETKEY('L','O'), SETKEY('N','M'), SETKEY('U','0'), SETKEY('U','1'),
+  SETKEY('H','2'), SETKEY('K','2'), SETKEY('S','R'), SETKEY('S','C'), SETKEY('N','D'), SETKEY('R','B'),
+  SETKEY('N','N'), SETKEY('I','N')
+};
+
+//single pass over "win&key=value&...", val[] points into req at each value (nullptr if absent)
+inline void tokenizeSet(const char* req, const char* val[SK_COUNT])
+{
+  memset(val, 0, SK_COUNT * sizeof(const char*));
+  const char* p = req;
+  while ((p = strchr(p, '&')) != nullptr) {
+    const char* k = ++p;
+    uint8_t kl = 0;
+    while (k[kl] && k[kl] != '=' && k[kl] != '&' && kl < 3) kl++;
+    if (kl == 0 || kl > 2) continue;
+    bool hasVal = k[kl] == '=';
+    uint16_t code = SETKEY(k[0], kl > 1 ? k[1] : 0);
+    for (uint8_t i = 0; i < SK_COUNT; i++) {
+      if (pgm_read_word(&setKeyCodes[i]) != code) continue;
+      if (val[i]) break; //the first occurrence of a key wins
+      if (hasVal || i >= SK_FLAGS) val[i] = k + kl + hasVal; //flags without value point to the next '&' or the end
+      break;
+    }
+  }
+}
+
+//relative HTTP API value after the '~': "~" and "~-" step by one and wrap around,
+//"~10" and "~-10" add and stop at the limits (or jump to the other limit if wrap is set and val is at one)
+inline uint8_t stepValue(const char* str, uint8_t val, uint8_t minv, uint8_t maxv, bool wrap)
+{
+  int out = atoi(str);
+  if (out == 0) {
+    if (str[0] == '0') return val;
+    if (str[0] == '-') return (int)val - 1 < (int)minv ? maxv : ((int)val - 1 > (int)maxv ? maxv : val - 1);
+    return (int)val + 1 > (int)maxv ? minv : ((int)val + 1 < (int)minv ? minv : val + 1);
+  }
+  if (wrap && val == maxv && out > 0) return minv;
+  if (wrap && val == minv && out < 0) return maxv;
+  out += val;
+  if (out > maxv) out = maxv;
+  if (out < minv) out = minv;
+  return out;
+}
+
+//frame recorder format, all values little endian: file header, then per frame a frame header
+//followed by the RGBW pixels unless the frame repeats the previous one
+#define REC_HEADER_SIZE 8  //"WREC", version, bytes per pixel, pixel count
+#define REC_FRAME_HEADER 6 //time in ms, brightness, flags
+#define REC_FLAG_REPEAT 0x01 //pixels unchanged since previous frame, no pixel data follows
+
+inline void recFileHeader(uint8_t* hdr, uint16_t pixels)
+{
+  memcpy(hdr, "WREC", 4);
+  hdr[4] = 1; //format version
+  hdr[5] = 4; //bytes per pixel
+  hdr[6] = pixels; hdr[7] = pixels >> 8;
+}
+
+inline void recFrameHeader(uint8_t* hdr, uint32_t ms, uint8_t bri, bool repeat)
+{
+  hdr[0] = ms; hdr[1] = ms >> 8; hdr[2] = ms >> 16; hdr[3] = ms >> 24;
+  hdr[4] = bri;
+  hdr[5] = repeat ? REC_FLAG_REPEAT : 0;
+}
+
+//frames of a file recording are staged in RAM by show() and written out later by the loop,
+//so show() never waits for the file system
+struct RecStage
+{
+  uint8_t* buf = nullptr;
+  uint32_t cap = 0, len = 0, dropped = 0;
+
+  bool begin(uint32_t size) { buf = (uint8_t*)malloc(size); cap = buf ? size : 0; len = dropped = 0; return buf; }
+  void end() { free(buf); buf = nullptr; cap = len = 0; }
+
+  //appends a frame, pixels nullptr if it repeats the previous one. false if the stage is full and the frame dropped
+  bool add(uint32_t ms, uint8_t bri, const uint8_t* pixels, uint32_t pixelLen)
+  {
+    uint32_t n = REC_FRAME_HEADER + (pixels ? pixelLen : 0);
+    if (len + n > cap) { dropped++; return false; }
+    recFrameHeader(buf + len, ms, bri, !pixels);
+    if (pixels) memcpy(buf + len + REC_FRAME_HEADER, pixels, pixelLen);
+    len += n;
+    return true;
+  }
+
+  //hands the staged frames to write(data, len), which returns the bytes written, and empties the stage
+  template <typename W>
+  uint32_t flush(W write)
+  {
+    uint32_t n = len ? write(buf, len) : 0;
+    len = 0;
+    return n;
+  }
+};
+
+#endif
@@ -39,6 +39,19 @@ void colorRGBtoRGBW(byte* rgb);
 #define B(c) (byte(c))
 #define W(c) (byte((c) >> 24))
 
+//reasons for a bus config to be rejected by BusManager::plan()
+#define BUS_REJECT_NONE  0
+#define BUS_REJECT_LIMIT 1 //exceeds MAX_LED_MEMORY
+#define BUS_REJECT_HEAP  2 //not enough free heap
+#define BUS_REJECT_PSRAM 3 //not enough free PSRAM
+#define BUS_REJECT_PREV  4 //a preceding bus was rejected (busses are admitted in order)
+
+//result of admission planning for one bus config
+struct BusPlanEntry {
+  uint32_t mem;
+  uint8_t reject;
+};
+
 //temporary struct for passing bus configuration to bus
 struct BusConfig {
   uint8_t type = TYPE_WS2812_RGB;
@@ -144,13 +157,27 @@ class Bus {
 		virtual void     setStatusPixel(uint32_t c) {}
     virtual void     setPixelColor(uint16_t pix, uint32_t c) {}
     virtual uint32_t getPixelColor(uint16_t pix) { return 0; }
+    //span setters, pix is relative to bus start and span must lie within the bus
+    virtual void     fillPixels(uint16_t pix, uint16_t n, uint32_t c) {
+      for (uint16_t i = 0; i < n; i++) setPixelColor(pix + i, c);
+    }
+    //data is RGB (|stride| 3) or RGBW (|stride| >= 4), a negative stride walks data backwards
+    //lut (e.g. gamma table) is applied to every input channel if given
+    virtual void     writePixels(uint16_t pix, const uint8_t* data, uint16_t n, int8_t stride, const uint8_t* lut = nullptr) {
+      bool w = (stride > 3 || stride < -3);
+      for (uint16_t i = 0; i < n; i++, data += stride) {
+        if (lut) setPixelColor(pix + i, RGBW32(lut[data[0]], lut[data[1]], lut[data[2]], w ? lut[data[3]] : 0));
+        else     setPixelColor(pix + i, RGBW32(data[0], data[1], data[2], w ? data[3] : 0));
+      }
+    }
     virtual void     setBrightness(uint8_t b) {}
     virtual void     cleanup() {}
     virtual uint8_t  getPins(uint8_t* pinArray) { return 0; }
     virtual uint16_t getLength() { return _len; }
-    virtual void     setColorOrder() {}
+    virtual void     setColorOrder(uint8_t colorOrder) {}
     virtual uint8_t  getColorOrder() { return COL_ORDER_RGB; }
     virtual uint8_t  skippedLeds() { return 0; }
+    virtual uint32_t getMemUsage() { return sizeof(Bus); }
     inline  uint16_t getStart() { return _start; }
     inline  void     setStart(uint16_t start) { _start = start; }
     inline  uint8_t  getType() { return _type; }
@@ -177,6 +204,8 @@ class Bus {
 		}
 		inline static void    setAutoWhiteMode(uint8_t m) { if (m < 4) _autoWhiteMode = m; }
 		inline static uint8_t getAutoWhiteMode() { return _autoWhiteMode; }
+		//master brightness before its 8 bit gamma correction, 0 if brightness is not gamma corrected
+		inline static void    setGammaBri(uint8_t b) { _gammaBri = b; }
 
     bool reversed = false;
 
@@ -190,6 +219,7 @@ class Bus {
     static uint8_t _autoWhiteMode;
     static int16_t _cct;
 		static uint8_t _cctBlend;
+		static uint8_t _gammaBri;
   
     uint32_t autoWhiteCalc(uint32_t c) {
       if (_autoWhiteMode == RGBW_MODE_MANUAL_ONLY) return c;
@@ -203,6 +233,15 @@ class Bus {
       if (_autoWhiteMode == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; } //subtract w in ACCURATE mode
       return RGBW32(r, g, b, w);
     }
+
+    //repeats the first unit bytes of buf until len bytes are filled (doubling memcpy)
+    static void repeatFill(uint8_t* buf, size_t unit, size_t len) {
+      for (size_t done = unit; done < len; ) {
+        size_t c = (done < len - done) ? done : len - done;
+        memcpy(buf + done, buf, c);
+        done += c;
+      }
+    }
 };
 
 
@@ -266,6 +305,51 @@ class BusDigital : public Bus {
     PolyBus::setPixelColor(_busPtr, _iType, pix, c, _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder));
   }
 
+  //color conversion is done once for the whole span
+  void fillPixels(uint16_t pix, uint16_t n, uint32_t c) {
+    if (_type == TYPE_SK6812_RGBW || _type == TYPE_TM1814) c = autoWhiteCalc(c);
+    if (_cct >= 1900) c = colorBalanceFromKelvin(_cct, c); //color correction from CCT
+    for (uint16_t i = 0; i < n; i++) {
+      uint16_t p = pix + i;
+      if (reversed) p = _len - p -1;
+      else p += _skip;
+      PolyBus::setPixelColor(_busPtr, _iType, p, c, _colorOrderMap.getPixelColorOrder(p+_start, _colorOrder));
+    }
+  }
+
+  //copies straight into the NeoPixelBus buffer with one table for input lut and brightness and a fixed channel order.
+  //busses needing per pixel color correction (auto white, CCT, color order map) take the setPixelColor() path
+  void writePixels(uint16_t pix, const uint8_t* data, uint16_t n, int8_t stride, const uint8_t* lut = nullptr) {
+    bool rgbw = (_type == TYPE_SK6812_RGBW);
+    uint8_t* buf = nullptr;
+    #ifndef COLOR_ORDER_OVERRIDE
+    if (_cct < 1900 && _colorOrderMap.count() == 0 && (!rgbw || _autoWhiteMode == RGBW_MODE_MANUAL_ONLY))
+      buf = PolyBus::getPixels(_busPtr, _iType);
+    #endif
+    if (buf == nullptr) {
+      Bus::writePixels(pix, data, n, stride, lut);
+      return;
+    }
+    //NeoPixelBrightnessBus scales by (bri+1)/256 on SetPixelColor()
+    uint8_t t[256];
+    uint16_t scale = (_bri == 255) ? 256 : _bri + 1;
+    for (uint16_t v = 0; v < 256; v++) t[v] = ((lut ? lut[v] : v) * scale) >> 8;
+    //source channel (R=0, G=1, B=2) for each output byte of the GRB(W) feature, see PolyBus::setPixelColor()
+    static const uint8_t order[6][3] = {{1,0,2},{0,1,2},{2,0,1},{0,2,1},{2,1,0},{1,2,0}};
+    const uint8_t* o = order[_colorOrder > 5 ? 5 : _colorOrder];
+    bool w = (stride > 3 || stride < -3);
+    uint8_t ch = rgbw ? 4 : 3;
+    int8_t step = ch;
+    uint8_t* out = buf + (reversed ? _len - pix - 1 : pix + _skip) * ch;
+    if (reversed) step = -step;
+    for (uint16_t i = 0; i < n; i++, data += stride, out += step) {
+      out[0] = t[data[o[0]]];
+      out[1] = t[data[o[1]]];
+      out[2] = t[data[o[2]]];
+      if (rgbw) out[3] = w ? t[data[3]] : 0;
+    }
+  }
+
   uint32_t getPixelColor(uint16_t pix) {
     if (reversed) pix = _len - pix -1;
     else pix += _skip;
@@ -295,6 +379,10 @@ class BusDigital : public Bus {
     return _skip;
   }
 
+  uint32_t getMemUsage() {
+    return sizeof(BusDigital) + PolyBus::memUsage(_type, _iType, _len);
+  }
+
   inline void reinit() {
     PolyBus::begin(_busPtr, _iType, _pins);
   }
@@ -331,7 +419,7 @@ class BusPwm : public Bus {
     uint8_t numPins = NUM_PWM_PINS(bc.type);
 
     #ifdef ESP8266
-    analogWriteRange(255);  //same range as one RGB channel
+    analogWriteRange((1 << WLED_PWM_BITS) - 1);
     analogWriteFreq(WLED_PWM_FREQ);
     #else
     _ledcStart = pinManager.allocateLedc(numPins);
@@ -349,16 +437,18 @@ class BusPwm : public Bus {
       #ifdef ESP8266
       pinMode(_pins[i], OUTPUT);
       #else
-      ledcSetup(_ledcStart + i, WLED_PWM_FREQ, 8);
+      ledcSetup(_ledcStart + i, WLED_PWM_FREQ, WLED_PWM_BITS);
       ledcAttachPin(_pins[i], _ledcStart + i);
       #endif
     }
     reversed = bc.reversed;
+    computeLUT();
     _valid = true;
   };
 
   void setPixelColor(uint16_t pix, uint32_t c) {
     if (pix != 0 || !_valid) return; //only react to first pixel
+    _dirty = true;
 		if (_type != TYPE_ANALOG_3CH) c = autoWhiteCalc(c);
     if (_cct >= 1900 && (_type == TYPE_ANALOG_3CH || _type == TYPE_ANALOG_4CH)) {
       c = colorBalanceFromKelvin(_cct, c); //color correction from CCT
@@ -417,22 +507,50 @@ class BusPwm : public Bus {
     return RGBW32(_data[0], _data[1], _data[2], _data[3]);
   }
 
+  //outputs at WLED_PWM_BITS, the fractional part of the duty is dithered over consecutive frames.
+  //Dithering needs a steady frame rate, with frames further apart than WLED_PWM_DITHER_MS it would
+  //flicker visibly, so the duty is rounded instead
   void show() {
     if (!_valid) return;
     uint8_t numPins = NUM_PWM_PINS(_type);
+    if (_dirty) {
+      for (uint8_t i = 0; i < numPins; i++) _duty[i] = _lut[_data[i]];
+      _dirty = false;
+    }
+    #if WLED_PWM_DITHER_BITS > 0
+    unsigned long now = millis();
+    bool dither = now - _lastShow <= WLED_PWM_DITHER_MS;
+    _lastShow = now;
+    #endif
     for (uint8_t i = 0; i < numPins; i++) {
-      uint8_t scaled = (_data[i] * _bri) / 255;
-      if (reversed) scaled = 255 - scaled;
+      uint16_t out = _duty[i] >> WLED_PWM_DITHER_BITS;
+      #if WLED_PWM_DITHER_BITS > 0
+      if (!dither) {
+        out = (_duty[i] + (1 << (WLED_PWM_DITHER_BITS - 1))) >> WLED_PWM_DITHER_BITS;
+        _dither[i] = 0;
+      } else {
+        _dither[i] += _duty[i] & ((1 << WLED_PWM_DITHER_BITS) - 1);
+        if (_dither[i] >= (1 << WLED_PWM_DITHER_BITS)) {
+          _dither[i] -= (1 << WLED_PWM_DITHER_BITS);
+          out++;
+        }
+      }
+      #endif
+      if (reversed) out = ((1 << WLED_PWM_BITS) - 1) - out;
+      if (out == _out[i]) continue; //only write changed duty cycles
+      _out[i] = out;
       #ifdef ESP8266
-      analogWrite(_pins[i], scaled);
+      analogWrite(_pins[i], out);
       #else
-      ledcWrite(_ledcStart + i, scaled);
+      ledcWrite(_ledcStart + i, out);
       #endif
     }
   }
 
-  inline void setBrightness(uint8_t b) {
+  void setBrightness(uint8_t b) {
+    if (_bri == b && _lutGammaBri == _gammaBri) return;
     _bri = b;
+    computeLUT();
   }
 
   uint8_t getPins(uint8_t* pinArray) {
@@ -444,6 +562,10 @@ class BusPwm : public Bus {
     return numPins;
   }
 
+  uint32_t getMemUsage() {
+    return sizeof(BusPwm);
+  }
+
   inline void cleanup() {
     deallocatePins();
   }
@@ -455,10 +577,34 @@ class BusPwm : public Bus {
   private: 
   uint8_t _pins[5] = {255, 255, 255, 255, 255};
   uint8_t _data[5] = {0};
+  uint16_t _lut[256];      //channel value to duty cycle (incl. brightness and dither bits)
+  uint16_t _duty[5] = {0};
+  uint16_t _out[5] = {0};  //last written duty cycle
+  uint8_t _dither[5] = {0};
+  uint8_t _lutGammaBri = 0;
+  unsigned long _lastShow = 0;
+  bool _dirty = true;
   #ifdef ARDUINO_ARCH_ESP32
   uint8_t _ledcStart = 255;
   #endif
 
+  //brightness is applied at full PWM resolution instead of truncating channel*bri to 8 bit.
+  //With brightness gamma on, it follows the gamma curve (same 2.8 as gammaT) of the uncorrected brightness,
+  //so low brightness still dims smoothly where the 8 bit corrected value has few or no steps.
+  //Channel values arrive color corrected already. Only recomputed on brightness change
+  void computeLUT() {
+    const uint32_t full = ((1UL << WLED_PWM_BITS) - 1) << WLED_PWM_DITHER_BITS;
+    float scale = _bri / 255.0f;
+    _lutGammaBri = _gammaBri;
+    if (_gammaBri) {
+      float curve = powf(_gammaBri / 255.0f, 2.8f);
+      uint8_t bri8 = curve * 255.0f + 0.5f; //brightness the other busses get
+      scale = (_bri >= bri8) ? curve : curve * _bri / bri8; //lowered by ABL
+    }
+    for (uint16_t v = 0; v < 256; v++) _lut[v] = v * scale * full / 255.0f + 0.5f;
+    _dirty = true;
+  }
+
   void deallocatePins() {
     uint8_t numPins = NUM_PWM_PINS(_type);
     for (uint8_t i = 0; i < numPins; i++) {
@@ -495,11 +641,15 @@ class BusNetwork : public Bus {
 //          _UDPtype = 0;
 //          break;
 //        default:
-          _rgbw = false;
+          _rgbw = Bus::isRgbw(bc.type);
           _UDPtype = bc.type - TYPE_NET_DDP_RGB;
 //          break;
 //      }
-      _UDPchannels = _rgbw ? 4 : 3;
+      _UDPchannels = channels(bc.type);
+      #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_USE_PSRAM)
+      if (psramFound()) _data = (byte *)ps_malloc(bc.count * _UDPchannels);
+      else
+      #endif
       _data = (byte *)malloc(bc.count * _UDPchannels);
       if (_data == nullptr) return;
       memset(_data, 0, bc.count * _UDPchannels);
@@ -509,6 +659,9 @@ class BusNetwork : public Bus {
       _valid = true;
     };
 
+  //bytes per pixel sent for a bus type
+  static uint8_t channels(uint8_t type) { return Bus::isRgbw(type) ? 4 : 3; }
+
   void setPixelColor(uint16_t pix, uint32_t c) {
     if (!_valid || pix >= _len) return;
 		if (isRgbw()) c = autoWhiteCalc(c);
@@ -520,6 +673,21 @@ class BusNetwork : public Bus {
     if (_rgbw) _data[offset+3] = W(c);
   }
 
+  void fillPixels(uint16_t pix, uint16_t n, uint32_t c) {
+    if (!_valid || pix >= _len || !n) return;
+    if (n > _len - pix) n = _len - pix;
+    setPixelColor(pix, c);
+    repeatFill(_data + pix * _UDPchannels, _UDPchannels, n * _UDPchannels);
+  }
+
+  void writePixels(uint16_t pix, const uint8_t* data, uint16_t n, int8_t stride, const uint8_t* lut = nullptr) {
+    if (!_valid || pix >= _len) return;
+    if (n > _len - pix) n = _len - pix;
+    //no color correction needed, copy as-is
+    if (!lut && stride == _UDPchannels && !_rgbw && _cct < 1900) memcpy(_data + pix * _UDPchannels, data, n * _UDPchannels);
+    else Bus::writePixels(pix, data, n, stride, lut);
+  }
+
   uint32_t getPixelColor(uint16_t pix) {
     if (!_valid || pix >= _len) return 0;
     uint16_t offset = pix * _UDPchannels;
@@ -557,6 +725,10 @@ class BusNetwork : public Bus {
     return _len;
   }
 
+  uint32_t getMemUsage() {
+    return sizeof(BusNetwork) + (_data ? _len * _UDPchannels : 0);
+  }
+
   void cleanup() {
     _type = I_NONE;
     _valid = false;
@@ -579,46 +751,306 @@ class BusNetwork : public Bus {
 };
 
 
+#ifdef WLED_ENABLE_RECORDER
+#include "api_helpers.h" //recording format and RecStage
+
+//records every shown frame, to a RAM ring buffer (TYPE_REC_RAM) or to REC_FILE_NAME (TYPE_REC_FILE)
+//pixel data is RGBW as set by the engine, brightness is stored per frame.
+//File recordings are staged in RAM by show() and written by flush() from the loop
+class BusRecorder : public Bus {
+  public:
+  BusRecorder(BusConfig &bc) : Bus(bc.type, bc.start) {
+    _valid = false;
+    _len = bc.count;
+    _frameSize = REC_FRAME_HEADER + _len * 4;
+    _data = (uint8_t*)calloc(_len, 4);
+    if (_data == nullptr) return;
+    if (_type == TYPE_REC_RAM) {
+      _slots = REC_RAM_SIZE / _frameSize;
+      if (!_slots) _slots = 1;
+      _ring = (uint8_t*)malloc(_slots * _frameSize);
+      if (_ring == nullptr) { cleanup(); return; }
+    } else {
+      uint32_t stage = (REC_STAGE_SIZE > 2 * _frameSize) ? REC_STAGE_SIZE : 2 * _frameSize;
+      if (!_stage.begin(stage)) { cleanup(); return; }
+      _file = WLED_FS.open(REC_FILE_NAME, "w");
+      if (!_file) { cleanup(); return; }
+      uint8_t hdr[REC_HEADER_SIZE];
+      recFileHeader(hdr, _len);
+      _fileLen = _file.write(hdr, REC_HEADER_SIZE);
+    }
+    _valid = true;
+  }
+
+  void setPixelColor(uint16_t pix, uint32_t c) {
+    if (!_valid || pix >= _len) return;
+    uint8_t* p = _data + pix * 4;
+    uint8_t r = R(c), g = G(c), b = B(c), w = W(c);
+    if (p[0] == r && p[1] == g && p[2] == b && p[3] == w) return;
+    p[0] = r; p[1] = g; p[2] = b; p[3] = w;
+    _changed = true;
+  }
+
+  void fillPixels(uint16_t pix, uint16_t n, uint32_t c) {
+    if (!_valid || pix >= _len || !n) return;
+    if (n > _len - pix) n = _len - pix;
+    uint8_t* p = _data + pix * 4;
+    p[0] = R(c); p[1] = G(c); p[2] = B(c); p[3] = W(c);
+    repeatFill(p, 4, n * 4);
+    _changed = true;
+  }
+
+  void writePixels(uint16_t pix, const uint8_t* data, uint16_t n, int8_t stride, const uint8_t* lut = nullptr) {
+    if (!_valid || pix >= _len) return;
+    if (n > _len - pix) n = _len - pix;
+    if (!lut && stride == 4) memcpy(_data + pix * 4, data, n * 4);
+    else Bus::writePixels(pix, data, n, stride, lut);
+    _changed = true;
+  }
+
+  uint32_t getPixelColor(uint16_t pix) {
+    if (!_valid || pix >= _len) return 0;
+    uint8_t* p = _data + pix * 4;
+    return RGBW32(p[0], p[1], p[2], p[3]);
+  }
+
+  void show() {
+    if (!_valid) return;
+    _writing = true;
+    if (_holds) { _writing = false; return; } //download in progress
+    uint32_t t = millis();
+    if (_ring) { //RAM ring always stores complete frames so the oldest one is self-contained
+      uint8_t* slot = _ring + _head * _frameSize;
+      recFrameHeader(slot, t, _bri, false);
+      memcpy(slot + REC_FRAME_HEADER, _data, _len * 4);
+      _head = (_head + 1) % _slots;
+      if (_frames < _slots) _frames++;
+    } else if (_file && !_full) {
+      if (_fileLen + _stage.len + _frameSize > REC_FILE_MAX) { _full = true; _writing = false; return; } //stop recording
+      //a dropped frame (loop not flushing fast enough) keeps _changed, so the next one is complete
+      if (!_stage.add(t, _bri, _changed ? _data : nullptr, _len * 4)) { _writing = false; return; }
+    }
+    _changed = false;
+    _writing = false;
+  }
+
+  //writes the staged frames to the file, called by the loop
+  void flush() {
+    if (!_file) return;
+    _writing = true;
+    if (!_holds) writeStage();
+    _writing = false;
+  }
+
+  inline void setBrightness(uint8_t b) {
+    _bri = b;
+  }
+
+  //stops recording until release() while a download is in progress, flushes the file
+  //hold() and release() are called from the webserver, show() may be running in the loop task on ESP32
+  void hold() {
+    _holds++;
+    for (uint8_t i = 0; _writing && i < 50; i++) delay(1); //let a frame being written finish
+    if (!_file) return;
+    writeStage();
+    if (_file) _file.flush();
+  }
+
+  void release() {
+    if (_holds) _holds--;
+  }
+
+  //size of the recording held in RAM (file recordings are served from FS)
+  uint32_t getRecordingSize() {
+    if (!_ring) return 0;
+    return REC_HEADER_SIZE + _frames * _frameSize;
+  }
+
+  //copies up to maxLen bytes of the RAM recording from byte offset index, returns bytes copied
+  size_t readRecording(uint8_t* buf, size_t maxLen, size_t index) {
+    uint32_t total = getRecordingSize();
+    if (index >= total) return 0;
+    if (maxLen > total - index) maxLen = total - index;
+    size_t copied = 0;
+    while (copied < maxLen) {
+      size_t pos = index + copied;
+      size_t n;
+      if (pos < REC_HEADER_SIZE) {
+        uint8_t hdr[REC_HEADER_SIZE];
+        recFileHeader(hdr, _len);
+        n = min(maxLen - copied, (size_t)(REC_HEADER_SIZE - pos));
+        memcpy(buf + copied, hdr + pos, n);
+      } else {
+        pos -= REC_HEADER_SIZE;
+        uint16_t frame = pos / _frameSize;
+        uint16_t slot  = (_head + _slots - _frames + frame) % _slots; //oldest frame first
+        size_t off = pos % _frameSize;
+        n = min(maxLen - copied, (size_t)(_frameSize - off));
+        memcpy(buf + copied, _ring + slot * _frameSize + off, n);
+      }
+      copied += n;
+    }
+    return copied;
+  }
+
+  uint32_t getMemUsage() {
+    return sizeof(BusRecorder) + _len * 4 + (_ring ? _slots * _frameSize : 0) + _stage.cap;
+  }
+
+  void cleanup() {
+    _type = I_NONE;
+    _valid = false;
+    if (_file) { writeStage(); _file.close(); }
+    _stage.end();
+    if (_data != nullptr) free(_data);
+    if (_ring != nullptr) free(_ring);
+    _data = _ring = nullptr;
+  }
+
+  ~BusRecorder() {
+    cleanup();
+  }
+
+  private:
+  uint8_t* _data = nullptr;
+  uint8_t* _ring = nullptr;
+  uint32_t _frameSize;
+  uint16_t _slots = 0;
+  uint16_t _head = 0;
+  uint16_t _frames = 0;
+  volatile uint8_t _holds = 0;  //downloads in progress
+  volatile bool _writing = false; //show() is storing a frame or flush() writing the stage
+  bool     _changed = true; //first frame is always complete
+  bool     _full = false;   //REC_FILE_MAX reached, the file is closed once the stage is written
+  File     _file;
+  RecStage _stage;
+  uint32_t _fileLen = 0;
+
+  void writeStage() {
+    _fileLen += _stage.flush([this](const uint8_t* d, uint32_t n) { return (uint32_t)_file.write(d, n); });
+    if (_full) _file.close();
+  }
+};
+#endif
+
 class BusManager {
   public:
   BusManager() {
 
   };
 
-  //utility to get the approx. memory usage of a given BusConfig
-  static uint32_t memUsage(BusConfig &bc) {
-    uint8_t type = bc.type;
-    uint16_t len = bc.count + bc.skipAmount;
-    if (type > 15 && type < 32) {
-      #ifdef ESP8266
-        if (bc.pins[0] == 3) { //8266 DMA uses 5x the mem
-          if (type > 29) return len*20; //RGBW
-          return len*15;
-        }
-        if (type > 29) return len*4; //RGBW
-        return len*3;
-      #else //ESP32 RMT uses double buffer?
-        if (type > 29) return len*8; //RGBW
-        return len*6;
-      #endif
+  //memory a bus created from the given BusConfig will allocate (nr is the bus index, selects RMT/I2S on ESP32)
+  static uint32_t memUsage(BusConfig &bc, uint8_t nr = 0) {
+    if (bc.type >= TYPE_NET_DDP_RGB && bc.type < 96) return sizeof(BusNetwork) + bc.count * BusNetwork::channels(bc.type);
+    #ifdef WLED_ENABLE_RECORDER
+    if (IS_REC(bc.type)) {
+      uint32_t frameSize = REC_FRAME_HEADER + bc.count * 4;
+      uint32_t ring = (bc.type == TYPE_REC_RAM) ? max(REC_RAM_SIZE / frameSize, (uint32_t)1) * frameSize : 0;
+      return sizeof(BusRecorder) + bc.count * 4 + ring;
+    }
+    #endif
+    if (IS_DIGITAL(bc.type)) {
+      uint8_t iType = PolyBus::getI(bc.type, bc.pins, nr);
+      return sizeof(BusDigital) + PolyBus::memUsage(bc.type, iType, bc.count + bc.skipAmount);
     }
-    if (type > 31 && type < 48)   return 5;
-    if (type == 44 || type == 45) return len*4; //RGBW
-    return len*3; //RGB
+    return sizeof(BusPwm);
   }
-  
+
+  //checks a proposed set of configs (nullptr terminated) against MAX_LED_MEMORY and free heap/PSRAM
+  //busses identical to the existing one at their index need no new memory, the others free theirs first
+  //the result is kept for /json/info, returns the number of admitted configs
+  uint8_t plan(BusConfig* configs[]) {
+    uint32_t total = 0;
+    uint32_t heap = ESP.getFreeHeap();
+    uint32_t psram = 0;
+    #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_USE_PSRAM)
+    if (psramFound()) psram = ESP.getFreePsram();
+    #endif
+    for (uint8_t i = 0; i < numBusses; i++) {
+      if (i < WLED_MAX_BUSSES && configs[i] != nullptr && matches(busses[i], *configs[i])) continue;
+      uint32_t freed = busses[i]->getMemUsage();
+      if (psram && busses[i]->getType() >= TYPE_NET_DDP_RGB && busses[i]->getType() < 96) psram += freed;
+      else heap += freed;
+    }
+    heap = (heap > BUS_HEAP_RESERVE) ? heap - BUS_HEAP_RESERVE : 0;
+
+    uint8_t admitted = 0;
+    numPlanned = 0;
+    for (; numPlanned < WLED_MAX_BUSSES && configs[numPlanned] != nullptr; numPlanned++) {
+      BusConfig &bc = *configs[numPlanned];
+      BusPlanEntry &e = planned[numPlanned];
+      e.mem = memUsage(bc, numPlanned);
+      e.reject = BUS_REJECT_NONE;
+      if (admitted < numPlanned) { e.reject = BUS_REJECT_PREV; continue; }
+      total += e.mem;
+      if (total > MAX_LED_MEMORY) e.reject = BUS_REJECT_LIMIT;
+      else if (numPlanned < numBusses && matches(busses[numPlanned], bc)) {} //kept, already allocated
+      else if (psram && bc.type >= TYPE_NET_DDP_RGB && bc.type < 96) {
+        if (e.mem > psram) e.reject = BUS_REJECT_PSRAM;
+        else psram -= e.mem;
+      } else {
+        if (e.mem > heap) e.reject = BUS_REJECT_HEAP;
+        else heap -= e.mem;
+      }
+      if (e.reject) DEBUG_PRINTF("Bus %u rejected (%u), needs %u bytes.\n", numPlanned, e.reject, e.mem);
+      else admitted++;
+    }
+    return admitted;
+  }
+
   int add(BusConfig &bc) {
     if (numBusses >= WLED_MAX_BUSSES) return -1;
-    if (bc.type >= TYPE_NET_DDP_RGB && bc.type < 96) {
-      busses[numBusses] = new BusNetwork(bc);
-    } else if (IS_DIGITAL(bc.type)) {
-      busses[numBusses] = new BusDigital(bc, numBusses, colorOrderMap);
-    } else {
-      busses[numBusses] = new BusPwm(bc);
-    }
+    busses[numBusses] = create(bc, numBusses);
     return numBusses++;
   }
 
+  //true if the bus can be kept as-is for the given config (only order and reversal may differ)
+  static bool matches(Bus* bus, BusConfig &bc) {
+    if (bus == nullptr || !bus->isOk()) return false;
+    if (bus->getType() != bc.type || bus->getStart() != bc.start) return false;
+    if (bus->getLength() != bc.count || bus->skippedLeds() != bc.skipAmount) return false;
+    if (IS_DIGITAL(bc.type) && bus->isOffRefreshRequired() != (bc.refreshReq || bc.type == TYPE_TM1814)) return false;
+    uint8_t pins[5];
+    uint8_t nPins = bus->getPins(pins);
+    for (uint8_t i = 0; i < nPins; i++) if (pins[i] != bc.pins[i]) return false;
+    return true;
+  }
+
+  //applies a new set of configs (nullptr terminated, consumed), rebuilding only busses that changed
+  //busses keep their index (RMT/I2S channel on ESP32), unchanged ones keep their pixel buffers
+  //returns the number of (re)created busses
+  //do not call this method from system context (network callback)
+  uint8_t reconfigure(BusConfig* configs[]) {
+    uint8_t count = plan(configs);
+
+    //prevents crashes due to deleting busses while in use
+    while (!canAllShow()) yield();
+    //free changed busses first so their pins are available to the new ones
+    for (uint8_t i = 0; i < numBusses; i++) {
+      if (i < count && matches(busses[i], *configs[i])) continue;
+      delete busses[i]; busses[i] = nullptr;
+    }
+
+    uint8_t rebuilt = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      if (i < numBusses && busses[i] != nullptr) {
+        busses[i]->reversed = configs[i]->reversed;
+        busses[i]->setColorOrder(configs[i]->colorOrder);
+        continue;
+      }
+      busses[i] = create(*configs[i], i);
+      rebuilt++;
+    }
+    numBusses = count;
+    DEBUG_PRINTF("Reconfigured busses, %u of %u rebuilt.\n", rebuilt, count);
+
+    for (uint8_t i = 0; i < WLED_MAX_BUSSES; i++) {
+      if (configs[i] == nullptr) break;
+      delete configs[i]; configs[i] = nullptr;
+    }
+    return rebuilt;
+  }
+
   //do not call this method from system context (network callback)
   void removeAll() {
     DEBUG_PRINTLN(F("Removing all."));
@@ -649,12 +1081,49 @@ class BusManager {
     }
   }
 
+  //sets n consecutive pixels starting at pix, bus lookup is done once per bus instead of per pixel
+  void fillPixels(uint16_t pix, uint16_t n, uint32_t c) {
+    uint32_t end = (uint32_t)pix + n;
+    for (uint8_t i = 0; i < numBusses; i++) {
+      Bus* b = busses[i];
+      uint16_t bstart = b->getStart();
+      uint32_t bend = bstart + b->getLength();
+      uint16_t s = (pix > bstart) ? pix : bstart;
+      uint32_t e = (end < bend) ? end : bend;
+      if (s >= e) continue;
+      b->fillPixels(s - bstart, e - s, c);
+    }
+  }
+
+  //same as fillPixels(), colors are taken from data (see Bus::writePixels())
+  void writePixels(uint16_t pix, const uint8_t* data, uint16_t n, int8_t stride, const uint8_t* lut = nullptr) {
+    uint32_t end = (uint32_t)pix + n;
+    for (uint8_t i = 0; i < numBusses; i++) {
+      Bus* b = busses[i];
+      uint16_t bstart = b->getStart();
+      uint32_t bend = bstart + b->getLength();
+      uint16_t s = (pix > bstart) ? pix : bstart;
+      uint32_t e = (end < bend) ? end : bend;
+      if (s >= e) continue;
+      b->writePixels(s - bstart, data + (int32_t)(s - pix) * stride, e - s, stride, lut);
+    }
+  }
+
   void setBrightness(uint8_t b) {
     for (uint8_t i = 0; i < numBusses; i++) {
       busses[i]->setBrightness(b);
     }
   }
 
+  #ifdef WLED_ENABLE_RECORDER
+  //writes the frames file recorders staged during show(), called by the loop
+  void flushRecorders() {
+    for (uint8_t i = 0; i < numBusses; i++) {
+      if (busses[i]->getType() == TYPE_REC_FILE) static_cast<BusRecorder*>(busses[i])->flush();
+    }
+  }
+  #endif
+
   void setSegmentCCT(int16_t cct, bool allowWBCorrection = false) {
     if (cct > 255) cct = 255;
     if (cct >= 0) {
@@ -705,9 +1174,37 @@ class BusManager {
     return colorOrderMap;
   }
 
+  //memory allocated by all busses
+  uint32_t getMemUsage() {
+    uint32_t mem = 0;
+    for (uint8_t i = 0; i < numBusses; i++) mem += busses[i]->getMemUsage();
+    return mem;
+  }
+
+  //result of the last plan(), one entry per proposed config
+  inline uint8_t getNumPlanned() {
+    return numPlanned;
+  }
+
+  const BusPlanEntry* getPlanned(uint8_t n) const {
+    if (n >= numPlanned) return nullptr;
+    return &planned[n];
+  }
+
   private:
   uint8_t numBusses = 0;
   Bus* busses[WLED_MAX_BUSSES];
   ColorOrderMap colorOrderMap;
+  uint8_t numPlanned = 0;
+  BusPlanEntry planned[WLED_MAX_BUSSES];
+
+  Bus* create(BusConfig &bc, uint8_t nr) {
+    if (bc.type >= TYPE_NET_DDP_RGB && bc.type < 96) return new BusNetwork(bc);
+    #ifdef WLED_ENABLE_RECORDER
+    if (IS_REC(bc.type)) return new BusRecorder(bc);
+    #endif
+    if (IS_DIGITAL(bc.type)) return new BusDigital(bc, nr, colorOrderMap);
+    return new BusPwm(bc);
+  }
 };
 #endif
@@ -703,6 +703,73 @@ class PolyBus {
     }
   }
 
+  //raw pixel buffer of NeoPixel (GRB/GRBW feature) busses for span writes, marks the bus dirty. nullptr for other features
+  static uint8_t* getPixels(void* busPtr, uint8_t busType) {
+    switch (busType) {
+    #ifdef ESP8266
+      case I_8266_U0_NEO_3: (static_cast<B_8266_U0_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_8266_U0_NEO_3*>(busPtr))->Pixels();
+      case I_8266_U1_NEO_3: (static_cast<B_8266_U1_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_8266_U1_NEO_3*>(busPtr))->Pixels();
+      case I_8266_DM_NEO_3: (static_cast<B_8266_DM_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_8266_DM_NEO_3*>(busPtr))->Pixels();
+      case I_8266_BB_NEO_3: (static_cast<B_8266_BB_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_8266_BB_NEO_3*>(busPtr))->Pixels();
+      case I_8266_U0_NEO_4: (static_cast<B_8266_U0_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_8266_U0_NEO_4*>(busPtr))->Pixels();
+      case I_8266_U1_NEO_4: (static_cast<B_8266_U1_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_8266_U1_NEO_4*>(busPtr))->Pixels();
+      case I_8266_DM_NEO_4: (static_cast<B_8266_DM_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_8266_DM_NEO_4*>(busPtr))->Pixels();
+      case I_8266_BB_NEO_4: (static_cast<B_8266_BB_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_8266_BB_NEO_4*>(busPtr))->Pixels();
+      case I_8266_U0_400_3: (static_cast<B_8266_U0_400_3*>(busPtr))->Dirty(); return (static_cast<B_8266_U0_400_3*>(busPtr))->Pixels();
+      case I_8266_U1_400_3: (static_cast<B_8266_U1_400_3*>(busPtr))->Dirty(); return (static_cast<B_8266_U1_400_3*>(busPtr))->Pixels();
+      case I_8266_DM_400_3: (static_cast<B_8266_DM_400_3*>(busPtr))->Dirty(); return (static_cast<B_8266_DM_400_3*>(busPtr))->Pixels();
+      case I_8266_BB_400_3: (static_cast<B_8266_BB_400_3*>(busPtr))->Dirty(); return (static_cast<B_8266_BB_400_3*>(busPtr))->Pixels();
+    #endif
+    #ifdef ARDUINO_ARCH_ESP32
+      case I_32_RN_NEO_3: (static_cast<B_32_RN_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_32_RN_NEO_3*>(busPtr))->Pixels();
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I0_NEO_3: (static_cast<B_32_I0_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_32_I0_NEO_3*>(busPtr))->Pixels();
+      #endif
+      #if !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32C3)
+      case I_32_I1_NEO_3: (static_cast<B_32_I1_NEO_3*>(busPtr))->Dirty(); return (static_cast<B_32_I1_NEO_3*>(busPtr))->Pixels();
+      #endif
+      case I_32_RN_NEO_4: (static_cast<B_32_RN_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_32_RN_NEO_4*>(busPtr))->Pixels();
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I0_NEO_4: (static_cast<B_32_I0_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_32_I0_NEO_4*>(busPtr))->Pixels();
+      #endif
+      #if !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32C3)
+      case I_32_I1_NEO_4: (static_cast<B_32_I1_NEO_4*>(busPtr))->Dirty(); return (static_cast<B_32_I1_NEO_4*>(busPtr))->Pixels();
+      #endif
+      case I_32_RN_400_3: (static_cast<B_32_RN_400_3*>(busPtr))->Dirty(); return (static_cast<B_32_RN_400_3*>(busPtr))->Pixels();
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I0_400_3: (static_cast<B_32_I0_400_3*>(busPtr))->Dirty(); return (static_cast<B_32_I0_400_3*>(busPtr))->Pixels();
+      #endif
+      #if !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32C3)
+      case I_32_I1_400_3: (static_cast<B_32_I1_400_3*>(busPtr))->Dirty(); return (static_cast<B_32_I1_400_3*>(busPtr))->Pixels();
+      #endif
+    #endif
+    }
+    return nullptr;
+  }
+
+  //heap allocated by NeoPixelBus for a driver (pixel buffer plus driver side buffers), as of NeoPixelBus 2.6.9
+  static uint32_t memUsage(uint8_t busType, uint8_t iType, uint16_t len) {
+    if (iType == I_NONE) return 0;
+    uint32_t size = len * 3;
+    if (busType == TYPE_SK6812_RGBW || busType == TYPE_TM1814 || busType == TYPE_APA102) size = len * 4;
+    switch (iType) {
+    #ifdef ESP8266
+      //DMA keeps the pixel buffer and an I2S buffer with 4 bytes per data byte
+      case I_8266_DM_NEO_3: case I_8266_DM_NEO_4: case I_8266_DM_400_3: case I_8266_DM_TM1_4:
+        return size * 5;
+    #else
+      //RMT keeps an editing and a sending buffer
+      case I_32_RN_NEO_3: case I_32_RN_NEO_4: case I_32_RN_400_3: case I_32_RN_TM1_4:
+        return size * 2;
+      //I2S keeps the pixel buffer and a DMA buffer with 4 bytes per data byte
+      case I_32_I0_NEO_3: case I_32_I0_NEO_4: case I_32_I0_400_3: case I_32_I0_TM1_4:
+      case I_32_I1_NEO_3: case I_32_I1_NEO_4: case I_32_I1_400_3: case I_32_I1_TM1_4:
+        return size * 5;
+    #endif
+    }
+    return size; //UART, bit bang and SPI methods only keep the pixel buffer
+  }
+
   //gives back the internal type index (I_XX_XXX_X above) for the input 
   static uint8_t getI(uint8_t busType, uint8_t* pins, uint8_t num = 0) {
     if (!IS_DIGITAL(busType)) return I_NONE;
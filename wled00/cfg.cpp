@@ -93,8 +93,6 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   
   if (fromFS || !ins.isNull()) {
     uint8_t s = 0;  // bus iterator
-    if (fromFS) busses.removeAll(); // can't safely manipulate busses directly in network callback
-    uint32_t mem = 0;
     for (JsonObject elm : ins) {
       if (s >= WLED_MAX_BUSSES) break;
       uint8_t pins[5] = {255, 255, 255, 255, 255};
@@ -116,18 +114,13 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       bool reversed = elm["rev"];
       bool refresh = elm["ref"] | false;
       ledType |= refresh << 7; // hack bit 7 to indicate strip requires off refresh
-      if (fromFS) {
-        BusConfig bc = BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst);
-        mem += BusManager::memUsage(bc);
-        if (mem <= MAX_LED_MEMORY && busses.getNumBusses() <= WLED_MAX_BUSSES) busses.add(bc);  // finalization will be done in WLED::beginStrip()
-      } else {
-        if (busConfigs[s] != nullptr) delete busConfigs[s];
-        busConfigs[s] = new BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst);
-        doInitBusses = true;
-      }
+      if (busConfigs[s] != nullptr) delete busConfigs[s];
+      busConfigs[s] = new BusConfig(ledType, pins, start, length, colorOrder, reversed, skipFirst);
+      if (!fromFS) doInitBusses = true;
       s++;
     }
-    // finalization done in beginStrip()
+    // can't safely manipulate busses directly in network callback
+    if (fromFS) busses.reconfigure(busConfigs); // finalization done in beginStrip()
   }
   if (hw_led["rev"]) busses.getBus(0)->reversed = true; //set 0.11 global reversed setting for first bus
 
@@ -299,6 +292,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live[F("dmx")];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131FrameTimeout, if_live_dmx[F("ftimeout")]);
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   CJSON(DMXMode, if_live_dmx["mode"]);
 
@@ -307,6 +301,15 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(arlsForceMaxBri, if_live[F("maxbri")]);
   CJSON(arlsDisableGammaCorrection, if_live[F("no-gc")]); // false
   CJSON(arlsOffset, if_live[F("offset")]); // 0
+  CJSON(rtBufFrames, if_live[F("jbuf")]);   // 0 = off
+  CJSON(rtBufLatency, if_live[F("jlat")]);  // ms
+  CJSON(rtInterpolate, if_live[F("interp")]);
+  CJSON(udpMaxPackets, if_live[F("udppkt")]);
+  CJSON(udpMaxMs, if_live[F("udpms")]);
+  if (!udpMaxPackets) udpMaxPackets = 1;
+  if (!udpMaxMs) udpMaxMs = 1;
+  JsonArray if_live_routes = if_live[F("routes")];
+  if (!if_live_routes.isNull()) deserializeRealtimeRoutes(if_live_routes);
 
   CJSON(alexaEnabled, interfaces["va"][F("alexa")]); // false
 
@@ -472,7 +475,9 @@ void deserializeConfigFromFS() {
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(1)) return;
+  JsonDocument* pDoc = requestJSONBuffer(1, JSON_BUFFER_SIZE, JSON_POOL_WAIT);
+  if (!pDoc) return;
+  JsonDocument& doc = *pDoc;
   #endif
 
   DEBUG_PRINTLN(F("Reading settings from /cfg.json..."));
@@ -480,14 +485,14 @@ void deserializeConfigFromFS() {
   success = readObjectFromFile("/cfg.json", nullptr, &doc);
   if (!success) { //if file does not exist, try reading from EEPROM
     deEEPSettings();
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
     return;
   }
 
   // NOTE: This routine deserializes *and* applies the configuration
   //       Therefore, must also initialize ethernet from this function
   bool needsSave = deserializeConfig(doc.as<JsonObject>(), true);
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
 
   if (needsSave) serializeConfig(); // usermods required new prameters
 }
@@ -500,7 +505,9 @@ void serializeConfig() {
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(2)) return;
+  JsonDocument* pDoc = requestJSONBuffer(2, JSON_BUFFER_SIZE, JSON_POOL_WAIT);
+  if (!pDoc) { errorFlag = ERR_NOBUF; doSerializeConfig = true; return; } //retried from the loop
+  JsonDocument& doc = *pDoc;
   #endif
 
   JsonArray rev = doc.createNestedArray("rev");
@@ -712,6 +719,7 @@ void serializeConfig() {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("ftimeout")] = e131FrameTimeout;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx["mode"] = DMXMode;
 
@@ -719,6 +727,13 @@ void serializeConfig() {
   if_live[F("maxbri")] = arlsForceMaxBri;
   if_live[F("no-gc")] = arlsDisableGammaCorrection;
   if_live[F("offset")] = arlsOffset;
+  if_live[F("jbuf")] = rtBufFrames;
+  if_live[F("jlat")] = rtBufLatency;
+  if_live[F("interp")] = rtInterpolate;
+  if_live[F("udppkt")] = udpMaxPackets;
+  if_live[F("udpms")] = udpMaxMs;
+  JsonArray if_live_routes = if_live.createNestedArray(F("routes"));
+  serializeRealtimeRoutes(if_live_routes);
 
   JsonObject if_va = interfaces.createNestedObject("va");
   if_va[F("alexa")] = alexaEnabled;
@@ -839,7 +854,7 @@ void serializeConfig() {
   File f = WLED_FS.open("/cfg.json", "w");
   if (f) serializeJson(doc, f);
   f.close();
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
 }
 
 //settings in /wsec.json, not accessible via webserver, for passwords and tokens
@@ -849,12 +864,14 @@ bool deserializeConfigSec() {
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(3)) return false;
+  JsonDocument* pDoc = requestJSONBuffer(3, JSON_BUFFER_SIZE, JSON_POOL_WAIT);
+  if (!pDoc) return false;
+  JsonDocument& doc = *pDoc;
   #endif
 
   bool success = readObjectFromFile("/wsec.json", nullptr, &doc);
   if (!success) {
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
     return false;
   }
 
@@ -888,7 +905,7 @@ bool deserializeConfigSec() {
   CJSON(wifiLock, ota[F("lock-wifi")]);
   CJSON(aOtaEnabled, ota[F("aota")]);
 
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
   return true;
 }
 
@@ -898,7 +915,9 @@ void serializeConfigSec() {
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(4)) return;
+  JsonDocument* pDoc = requestJSONBuffer(4, JSON_BUFFER_SIZE, JSON_POOL_WAIT);
+  if (!pDoc) { errorFlag = ERR_NOBUF; doSerializeConfig = true; return; } //retried from the loop
+  JsonDocument& doc = *pDoc;
   #endif
 
   JsonObject nw = doc.createNestedObject("nw");
@@ -934,5 +953,5 @@ void serializeConfigSec() {
   File f = WLED_FS.open("/wsec.json", "w");
   if (f) serializeJson(doc, f);
   f.close();
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
 }
@@ -168,6 +168,10 @@
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
 #define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus)
+//Virtual types (96-111)
+#define TYPE_REC_RAM             96            //frame recorder, RAM ring buffer (WLED_ENABLE_RECORDER)
+#define TYPE_REC_FILE            97            //frame recorder, file on FS (WLED_ENABLE_RECORDER)
+#define IS_REC(t)     ((t) == TYPE_REC_RAM || (t) == TYPE_REC_FILE)
 
 #define IS_DIGITAL(t) ((t) & 0x10) //digital are 16-31 and 48-63
 #define IS_PWM(t)     ((t) > 40 && (t) < 46)
@@ -239,6 +243,7 @@
 // WLED Error modes
 #define ERR_NONE         0  // All good :)
 #define ERR_EEP_COMMIT   2  // Could not commit to EEPROM (wrong flash layout?)
+#define ERR_NOBUF        3  // JSON buffer was not available, the request can be retried
 #define ERR_JSON         9  // JSON parsing failed (input too large?)
 #define ERR_FS_BEGIN    10  // Could not init filesystem (no partition?)
 #define ERR_FS_QUOTA    11  // The FS is full or the maximum file size is reached
@@ -275,6 +280,50 @@
 #endif
 #endif
 
+//heap that must remain free after allocating bus buffers
+#ifndef BUS_HEAP_RESERVE
+#ifdef ESP8266
+#define BUS_HEAP_RESERVE 4096
+#else
+#define BUS_HEAP_RESERVE 16384
+#endif
+#endif
+
+#define WLED_MAX_RT_ROUTES 16  //realtime universe to segment routes
+
+//realtime jitter buffer
+#define RT_BUFFER_MAX_FRAMES 16
+#ifndef RT_BUFFER_MAX_MEM
+#ifdef ESP8266
+#define RT_BUFFER_MAX_MEM 12288      //bytes of heap for staging and queued frames
+#else
+#define RT_BUFFER_MAX_MEM 65536
+#endif
+#endif
+#ifndef RT_BUFFER_MAX_PSRAM
+#define RT_BUFFER_MAX_PSRAM 1048576  //limit if PSRAM is used
+#endif
+
+//frame recorder bus
+#ifndef REC_RAM_SIZE
+#ifdef ESP8266
+#define REC_RAM_SIZE 4096            //bytes of RAM ring buffer
+#else
+#define REC_RAM_SIZE 32768
+#endif
+#endif
+#ifndef REC_FILE_MAX
+#define REC_FILE_MAX 262144          //recording to FS stops at this size
+#endif
+#ifndef REC_STAGE_SIZE
+#ifdef ESP8266
+#define REC_STAGE_SIZE 2048          //bytes of RAM a file recording is staged in until the loop writes it
+#else
+#define REC_STAGE_SIZE 8192
+#endif
+#endif
+#define REC_FILE_NAME "/rec.bin"
+
 #ifndef MAX_LEDS_PER_BUS
 #define MAX_LEDS_PER_BUS 4096
 #endif
@@ -286,16 +335,6 @@
 #define SETTINGS_STACK_BUF_SIZE 3096 
 #endif
 
-#ifdef WLED_USE_ETHERNET
-  #define E131_MAX_UNIVERSE_COUNT 20
-#else
-  #ifdef ESP8266
-    #define E131_MAX_UNIVERSE_COUNT 9
-  #else
-    #define E131_MAX_UNIVERSE_COUNT 12
-  #endif
-#endif
-
 #ifndef ABL_MILLIAMPS_DEFAULT
   #define ABL_MILLIAMPS_DEFAULT 850  // auto lower brightness to stay close to milliampere limit
 #else
@@ -313,8 +352,31 @@
 #endif
 #endif
 
+// PWM resolution and fractional bits used for temporal dithering (sum must not exceed 16)
+#ifndef WLED_PWM_BITS
+#ifdef ESP8266
+  #define WLED_PWM_BITS       10
+#else
+  #define WLED_PWM_BITS       12 //max. for WLED_PWM_FREQ with 80MHz LEDC clock
+#endif
+#endif
+#ifndef WLED_PWM_DITHER_BITS
+  #define WLED_PWM_DITHER_BITS 4
+#endif
+#ifndef WLED_PWM_DITHER_MS
+  #define WLED_PWM_DITHER_MS  20 //dither only while frames are shown at least this often
+#endif
+
 #define TOUCH_THRESHOLD 32 // limit to recognize a touch, higher value means more sensitive
 
+// default UDP receive budget per loop() pass (runtime setting in cfg.json "if":"live":"udppkt"/"udpms")
+#ifndef UDP_MAX_PACKETS_PER_LOOP
+  #define UDP_MAX_PACKETS_PER_LOOP 16
+#endif
+#ifndef UDP_MAX_MS_PER_LOOP
+  #define UDP_MAX_MS_PER_LOOP 5
+#endif
+
 // Size of buffer for API JSON object (increase for more segments)
 #ifdef ESP8266
   #define JSON_BUFFER_SIZE 10240
@@ -322,6 +384,46 @@
   #define JSON_BUFFER_SIZE 20480
 #endif
 
+// JSON documents in the pool (one static full size, the rest JSON_POOL_SLOT_SIZE allocated from heap at boot)
+// config, presets and the HTTP/WS JSON API need JSON_BUFFER_SIZE and only get the static one
+#ifndef JSON_POOL_SLOTS
+  #ifdef ESP8266
+    #define JSON_POOL_SLOTS 2
+  #else
+    #define JSON_POOL_SLOTS 3
+  #endif
+#endif
+// JSON document for one part (state, a segment, info...) of a streamed /json response
+#ifndef JSON_STREAM_DOC_SIZE
+  #ifdef ESP8266
+    #define JSON_STREAM_DOC_SIZE 4096
+  #else
+    #define JSON_STREAM_DOC_SIZE 8192
+  #endif
+#endif
+#ifndef JSON_POOL_SLOT_SIZE
+  #define JSON_POOL_SLOT_SIZE JSON_STREAM_DOC_SIZE
+#endif
+#define JSON_POOL_WAIT 250         // ms the main loop waits for a document when saving or loading config
+#define JSON_INFO_REFRESH_MS 5000  // cached /json/info is rebuilt at least this often
+#define JSON_CACHE_IDLE_MS 60000   // cached /json/state and /json/info are freed after this long without polls
+
+// JSON API over UDP and MQTT: persistent parse arena and rate limit
+#ifndef REMOTE_JSON_SIZE
+  #ifdef ESP8266
+    #define REMOTE_JSON_SIZE 2048
+  #else
+    #define REMOTE_JSON_SIZE 4096
+  #endif
+#endif
+#define REMOTE_API_RATE  20      // API messages per second (sustained)
+#define REMOTE_API_BURST 10      // API messages accepted in a burst
+
+// binary pixel upload (POST /json/pixels or websocket binary message), see writePixelUpload()
+#define PIXEL_UPLOAD_MAGIC  'P'
+#define PIXEL_UPLOAD_HEADER 5    // magic, segment id, start (2 bytes, big endian), bytes per pixel
+#define WS_MAX_MSG_SIZE  4096    // fragmented binary websocket messages are reassembled up to this size
+
 #ifdef WLED_USE_DYNAMIC_JSON
   #define MIN_HEAP_SIZE JSON_BUFFER_SIZE+512
 #else
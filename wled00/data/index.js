@@ -2004,7 +2004,7 @@ function loadPalettesData(callback = null)
 
 function getPalettesData(page, callback)
 {
-	var url = `/json/palx?page=${page}`;
+	var url = `/json/palx?page=${page}&v=${lastinfo.vid}`; //versioned, so the browser may keep it
 	if (loc) {
 		url = `http://${locip}${url}`;
 	}
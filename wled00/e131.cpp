@@ -3,49 +3,422 @@
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
+#define DDP_MAX_PLAYOUT_DELAY 1000 //ms, pushes with a timecode further ahead are shown right away
 
 /*
  * E1.31 handler
  */
 
+//frame reassembly state for multi-universe E1.31/Art-Net, sized by e131UniverseCount() or the routed universes
+static uint16_t  e131Universes = 0;         //universes tracked (bit 0 = e131Universe)
+static uint32_t* e131FrameMask = nullptr;   //universes received for the current frame
+static uint32_t* e131LateMask = nullptr;    //universes missing from the last frame shown on timeout
+static byte*     e131SequenceNumber = nullptr; //last sequence number per universe, to detect packet loss
+static uint16_t  e131FrameCount = 0;        //universes received for the current frame
+static bool      e131LatePending = false;
+static unsigned long e131FrameStart = 0;
+static uint16_t e131SyncUniverse = 0;       //E1.31 synchronization address requested by the sender (0 = none)
+static unsigned long e131LastArtSync = 0;
+static uint16_t e131Joined = 0;             //universes joined for multicast
+static byte ddpLastSequenceNumber = 0;
+
+//packets are handled in the async UDP task on ESP32, while the loop resizes the tables and runs the frame timeout
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE e131FrameMux = portMUX_INITIALIZER_UNLOCKED;
+#define E131_FRAME_LOCK()   portENTER_CRITICAL(&e131FrameMux)
+#define E131_FRAME_UNLOCK() portEXIT_CRITICAL(&e131FrameMux)
+#else
+#define E131_FRAME_LOCK()
+#define E131_FRAME_UNLOCK()
+#endif
+
+//number of universes making up one frame in the current DMX mode, only limited by the LED count
+uint16_t e131UniverseCount() {
+  if (DMXMode != DMX_MODE_MULTIPLE_RGB && DMXMode != DMX_MODE_MULTIPLE_DRGB && DMXMode != DMX_MODE_MULTIPLE_RGBW) return 1;
+  bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  uint16_t dmxChannelsPerLed = is4Chan ? 4 : 3;
+  uint16_t ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+  uint16_t dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  if (DMXAddress + dimmerOffset > MAX_CHANNELS_PER_UNIVERSE) return 1;
+  uint16_t ledsInFirstUniverse = ((MAX_CHANNELS_PER_UNIVERSE - DMXAddress + 1) - dimmerOffset) / dmxChannelsPerLed;
+  uint16_t totalLen = strip.getLengthTotal();
+  if (totalLen <= ledsInFirstUniverse) return 1;
+  return 1 + (totalLen - ledsInFirstUniverse + ledsPerUniverse -1) / ledsPerUniverse;
+}
+
+//(re)allocates the per-universe state when the LED count or DMX mode changed, one buffer holds both masks
+//and the sequence numbers. Only called by the loop, packets are dropped until the tables are in place
+static void e131AllocUniverses(uint16_t n) {
+  static uint16_t failed = 0; //do not retry a failed size every loop
+  if (n == e131Universes || n == failed) return;
+  uint16_t words = (n + 31) / 32;
+  uint32_t* mask = (uint32_t*)calloc(2*words + (n + 3) / 4, sizeof(uint32_t));
+  E131_FRAME_LOCK();
+  uint32_t* old = e131FrameMask;
+  e131FrameMask = mask;
+  e131Universes = mask ? n : 0;
+  e131LateMask = mask ? mask + words : nullptr;
+  e131SequenceNumber = mask ? (byte*)(mask + 2*words) : nullptr;
+  e131FrameCount = 0;
+  e131LatePending = false;
+  E131_FRAME_UNLOCK();
+  free(old);
+  failed = mask ? 0 : n;
+  if (!mask) {
+    DEBUG_PRINTLN(F("E1.31 universe alloc failed!"));
+    return;
+  }
+  DEBUG_PRINT(F("E1.31 universes: "));
+  DEBUG_PRINTLN(n);
+}
+
+//marks the collected frame ready to be shown by handleNotifications()
+static void e131ShowFrame() {
+  if (e131FrameCount < e131Universes) {
+    e131TornFrames++;
+    realtimeStatTorn(realtimeMode);
+  }
+  e131Frames++;
+  memset(e131FrameMask, 0, ((e131Universes + 31) / 32) * sizeof(uint32_t));
+  e131FrameCount = 0;
+  e131SyncUniverse = 0;
+  e131NewData = true;
+}
+
+//called for every applied universe, shows the frame once all universes are in
+//if the sender uses E1.31 sync or ArtSync, the frame is shown on the sync packet instead
+//caller holds E131_FRAME_LOCK
+static void handleE131Frame(uint16_t idx, uint16_t syncUniverse) {
+  if (idx >= e131Universes) { e131NewData = true; return; }
+  uint32_t bit = 1UL << (idx & 31);
+  uint16_t w = idx >> 5;
+  if (e131LatePending) {
+    if (e131LateMask[w] & bit) { //belongs to a frame that was already shown on timeout
+      e131LateMask[w] &= ~bit;
+      e131LateFrames++;
+      return;
+    }
+    memset(e131LateMask, 0, ((e131Universes + 31) / 32) * sizeof(uint32_t));
+    e131LatePending = false;
+  }
+  if (e131FrameMask[w] & bit) e131ShowFrame(); //next frame started before the current one was complete
+  if (!e131FrameCount) e131FrameStart = millis();
+  e131FrameMask[w] |= bit;
+  e131FrameCount++;
+  if (syncUniverse) e131SyncUniverse = syncUniverse;
+
+  //Art-Net nodes return to non-synchronous mode 4s after the last ArtSync
+  bool artSync = e131LastArtSync && millis() - e131LastArtSync < 4000;
+  if (e131SyncUniverse || artSync) return;
+  if (e131FrameCount >= e131Universes) e131ShowFrame();
+}
+
+void handleE131Sync(e131_packet_t* p, byte protocol) {
+  if (protocol == P_ARTNET_SYNC) {
+    e131LastArtSync = millis();
+  } else if (!e131SyncUniverse || htons(p->sync_universe) != e131SyncUniverse) {
+    return;
+  }
+  E131_FRAME_LOCK();
+  if (e131FrameCount) e131ShowFrame();
+  E131_FRAME_UNLOCK();
+}
+
+//shows a frame if its missing universes (or the sync packet) did not arrive within e131FrameTimeout
+//also keeps the universe tables and multicast groups in line with the LED count, DMX mode and routes
+void handleE131FrameTimeout() {
+  e131AllocUniverses(rtRouteUniverses ? rtRouteUniverses : e131UniverseCount());
+  if (e131Multicast) {
+    uint16_t n = e131MulticastUniverses();
+    if (n != e131Joined) {
+      e131.setUniverseCount(n);
+      e131Joined = n;
+    }
+  }
+  if (!e131FrameCount || millis() - e131FrameStart < e131FrameTimeout) return;
+  E131_FRAME_LOCK();
+  if (e131FrameCount) { //frame may have completed meanwhile
+    uint16_t words = (e131Universes + 31) / 32;
+    for (uint16_t w = 0; w < words; w++) e131LateMask[w] = ~e131FrameMask[w];
+    if (e131Universes & 31) e131LateMask[words-1] &= (1UL << (e131Universes & 31)) -1;
+    e131LatePending = true;
+    e131ShowFrame();
+  }
+  E131_FRAME_UNLOCK();
+}
+
+/*
+ * Realtime routes: (protocol, universe, channel offset) -> (segment, pixel offset).
+ * Routed segments are frozen while live, all other segments keep running their effects.
+ */
+struct RealtimeRoute {
+  uint32_t key;      //protocol << 16 | universe
+  uint16_t ch;       //first channel (0 = first DMX channel of the universe, DDP channel offset)
+  uint8_t  seg;
+  uint8_t  stride;   //3 RGB, 4 RGBW
+  uint16_t px;       //pixel offset in the segment
+  uint16_t n;        //pixels, 0 = rest of segment
+  uint16_t start;    //resolved physical range
+  uint16_t len;
+  bool     reversed;
+  uint8_t  frame;    //E1.31/Art-Net: index of the universe in the frame tables
+};
+static RealtimeRoute rtRoutes[WLED_MAX_RT_ROUTES];
+static uint8_t rtRouteCount = 0;
+static uint16_t rtRoutedModes = 0;  //bit per realtime mode (protocol) that has routes
+static uint8_t rtRouteUniverses = 0; //distinct routed E1.31/Art-Net universes, they make up a frame
+
+static byte realtimeModeOf(uint8_t proto) {
+  return proto == P_ARTNET ? REALTIME_MODE_ARTNET : (proto == P_DDP ? REALTIME_MODE_DDP : REALTIME_MODE_E131);
+}
+
+//true if realtime data of this mode is routed to segments, other protocols use the whole strip
+bool realtimeRoutesActive(byte md) {
+  return rtRoutedModes & (1 << md);
+}
+
+bool realtimeRoutesActive() {
+  return realtimeRoutesActive(realtimeMode);
+}
+
+//maps routes to physical pixels, call after the routes or the segments changed
+void resolveRealtimeRoutes() {
+  for (uint8_t i = 0; i < rtRouteCount; i++) {
+    RealtimeRoute& r = rtRoutes[i];
+    r.len = 0;
+    if (r.seg >= strip.getMaxSegments()) continue;
+    WS2812FX::Segment& seg = strip.getSegment(r.seg);
+    if (!seg.isActive() || r.px >= seg.length()) continue;
+    r.len = seg.length() - r.px;
+    if (r.n && r.n < r.len) r.len = r.n;
+    r.reversed = seg.options & REVERSE;
+    r.start = r.reversed ? seg.stop - r.px - r.len : seg.start + r.px;
+  }
+}
+
+//freezes the segments routed from realtime mode md while live so effects do not overwrite them, clears them on entering live mode
+void freezeRealtimeRoutes(bool freeze, bool clear, byte md) {
+  for (uint8_t i = 0; i < rtRouteCount; i++) {
+    if (realtimeModeOf(rtRoutes[i].key >> 16) != md) continue;
+    uint8_t s = rtRoutes[i].seg;
+    if (s >= strip.getMaxSegments()) continue;
+    strip.getSegment(s).setOption(SEG_OPTION_FREEZE, freeze, s);
+    if (clear && rtRoutes[i].len) busses.fillPixels(rtRoutes[i].start, rtRoutes[i].len, 0);
+  }
+}
+
+//routes are kept sorted by key so a packet finds its first route with one binary search
+void deserializeRealtimeRoutes(JsonArray arr) {
+  rtRouteCount = 0;
+  for (JsonObject elem : arr) {
+    if (rtRouteCount >= WLED_MAX_RT_ROUTES) break;
+    RealtimeRoute r = {};
+    uint8_t proto = elem["p"] | P_E131;
+    uint16_t uni = elem[F("uni")] | 0;
+    if (proto > P_DDP) continue;
+    r.key = ((uint32_t)proto << 16) | (proto == P_DDP ? 0 : uni);
+    r.ch  = elem[F("ch")] | 0;
+    r.seg = elem[F("seg")] | 0;
+    r.stride = (elem["w"] | false) ? 4 : 3;
+    r.px  = elem[F("px")] | 0;
+    r.n   = elem["n"] | 0;
+    uint8_t j = rtRouteCount++;
+    while (j > 0 && rtRoutes[j-1].key > r.key) { rtRoutes[j] = rtRoutes[j-1]; j--; }
+    rtRoutes[j] = r;
+  }
+  rtRoutedModes = 0;
+  rtRouteUniverses = 0;
+  for (uint8_t i = 0; i < rtRouteCount; i++) {
+    uint8_t proto = rtRoutes[i].key >> 16;
+    rtRoutedModes |= 1 << realtimeModeOf(proto);
+    if (proto == P_DDP) continue;
+    if (i && rtRoutes[i-1].key == rtRoutes[i].key) rtRoutes[i].frame = rtRoutes[i-1].frame;
+    else rtRoutes[i].frame = rtRouteUniverses++;
+  }
+  resolveRealtimeRoutes();
+}
+
+void serializeRealtimeRoutes(JsonArray arr) {
+  for (uint8_t i = 0; i < rtRouteCount; i++) {
+    RealtimeRoute& r = rtRoutes[i];
+    JsonObject elem = arr.createNestedObject();
+    elem["p"] = r.key >> 16;
+    elem[F("uni")] = r.key & 0xFFFF;
+    elem[F("ch")] = r.ch;
+    elem[F("seg")] = r.seg;
+    if (r.stride == 4) elem["w"] = true;
+    elem[F("px")] = r.px;
+    elem["n"] = r.n;
+  }
+}
+
+//universes to join for multicast, also covers routed universes above e131Universe
+uint16_t e131MulticastUniverses() {
+  uint16_t n = e131UniverseCount();
+  for (uint8_t i = 0; i < rtRouteCount; i++) {
+    uint8_t proto = rtRoutes[i].key >> 16;
+    uint16_t uni = rtRoutes[i].key & 0xFFFF;
+    if (proto == P_DDP || uni < e131Universe) continue;
+    if (uni - e131Universe + 1 > n) n = uni - e131Universe + 1;
+  }
+  return n;
+}
+
+//index of the first route of a universe, -1 if it is not routed
+static int8_t findRealtimeRoute(uint8_t proto, uint16_t uni) {
+  uint32_t key = ((uint32_t)proto << 16) | uni;
+  uint8_t lo = 0, hi = rtRouteCount;
+  while (lo < hi) { //lower bound
+    uint8_t mid = (lo + hi) / 2;
+    if (rtRoutes[mid].key < key) lo = mid + 1; else hi = mid;
+  }
+  return (lo < rtRouteCount && rtRoutes[lo].key == key) ? lo : -1;
+}
+
+//writes channels [chOfs, chOfs+len) of a universe (or the DDP channel space) to the segments of its routes
+static void routeRealtimeData(int8_t first, uint32_t chOfs, const uint8_t* data, uint16_t len) {
+  if (first < 0) return;
+  uint32_t key = rtRoutes[first].key;
+  bool gamma = !arlsDisableGammaCorrection && strip.gammaCorrectCol;
+  const uint8_t* lut = gamma ? strip.getGammaTable() : nullptr;
+  uint32_t end = chOfs + len;
+  for (uint8_t i = first; i < rtRouteCount && rtRoutes[i].key == key; i++) {
+    RealtimeRoute& r = rtRoutes[i];
+    if (!r.len) continue;
+    uint32_t rEnd = r.ch + (uint32_t)r.len * r.stride;
+    uint32_t s = (chOfs > r.ch) ? chOfs : r.ch;
+    uint32_t e = (end < rEnd) ? end : rEnd;
+    if (s >= e) continue;
+    uint16_t p0 = (s - r.ch + r.stride - 1) / r.stride; //first whole pixel in the packet
+    uint16_t p1 = (e - r.ch) / r.stride;
+    if (p1 <= p0) continue;
+    const uint8_t* d = data + (r.ch + p0 * r.stride - chOfs);
+    uint16_t n = p1 - p0;
+    if (r.reversed) busses.writePixels(r.start + r.len - p1, d + (n - 1) * r.stride, n, -(int8_t)r.stride, lut);
+    else            busses.writePixels(r.start + p0, d, n, r.stride, lut);
+  }
+}
+
+//DDP timecode scheduled push
+static bool ddpPlayoutPending = false;
+static unsigned long ddpPlayoutAt = 0;
+
+//pushes the DDP frame at timecode tc (NTP time, 16 bit seconds and 16 bit fraction) if the clock is ms accurate
+//and tc is less than DDP_MAX_PLAYOUT_DELAY ahead, otherwise right away
+static void ddpPush(uint32_t tc) {
+  ddpPlayoutPending = false;
+  if (tc && rtBufFrames) { //the jitter buffer paces playout by the timecode
+    setRealtimeFrameStamp(((uint64_t)tc * 1000) >> 16);
+    e131NewData = true;
+    return;
+  }
+  if (tc && toki.getTimeSource() > 99) {
+    Toki::Time t = toki.getTime();
+    uint32_t now = ((t.sec + YEARS_70) << 16) | (((uint32_t)t.ms << 16) / 1000);
+    int32_t ms = ((int64_t)(int32_t)(tc - now) * 1000) >> 16;
+    if (ms > 0 && ms <= DDP_MAX_PLAYOUT_DELAY) {
+      ddpPlayoutAt = millis() + ms;
+      ddpPlayoutPending = true;
+      return;
+    }
+  }
+  e131NewData = true;
+}
+
+void handleDDPPlayout() {
+  if (!ddpPlayoutPending || (long)(millis() - ddpPlayoutAt) < 0) return;
+  ddpPlayoutPending = false;
+  e131NewData = true;
+}
+
 //DDP protocol support, called by handleE131Packet
-//handles RGB data only
-void handleDDPPacket(e131_packet_t* p) {
-  int lastPushSeq = e131LastSequenceNumber[0];
+//handles 8 bit RGB, RGBW and grayscale data, timecodes and status/config queries
+void handleDDPPacket(e131_packet_t* p, IPAddress clientIP) {
+  if ((p->flags & DDP_VERSION_MASK) != DDP_VERSION_1) return;
+  if (p->flags & DDP_REPLY_FLAG) return; //reply of another node
+
+  if (p->flags & DDP_QUERY_FLAG) {
+    if (p->destination == DDP_ID_STATUS || p->destination == DDP_ID_CONFIG)
+      sendDDPReply(clientIP, ddp.remotePort(), p->destination, p->sequenceNum);
+    return;
+  }
+  if (p->destination >= DDP_ID_CONFIG && p->destination != DDP_ID_ALL) return; //JSON config write, DMX
+
+  //8 bit elements only, most senders leave the data type (and size) 0
+  uint8_t ch;
+  if (p->dataType & DDP_TYPE_CUSTOM) return;
+  if (DDP_TYPE_SIZE(p->dataType) && DDP_TYPE_SIZE(p->dataType) != DDP_SIZE_8BIT) return;
+  switch (DDP_TYPE(p->dataType)) {
+    case DDP_TYPE_UNDEF:
+    case DDP_TYPE_RGB:  ch = 3; break;
+    case DDP_TYPE_RGBW: ch = 4; break;
+    case DDP_TYPE_GRAY: ch = 1; break;
+    default: return; //HSL
+  }
+
+  realtimeStatPacket(REALTIME_MODE_DDP, htons(p->dataLen));
+  int lastPushSeq = ddpLastSequenceNumber;
   
   //reject late packets belonging to previous frame (assuming 4 packets max. before push)
   if (e131SkipOutOfSequence && lastPushSeq) {
     int sn = p->sequenceNum & 0xF;
     if (sn) {
-      if (lastPushSeq > 5) {
-        if (sn > (lastPushSeq -5) && sn < lastPushSeq) return;
-      } else {
-        if (sn > (10 + lastPushSeq) || sn < lastPushSeq) return;
-      }
+      bool late;
+      if (lastPushSeq > 5) late = (sn > (lastPushSeq -5) && sn < lastPushSeq);
+      else                 late = (sn > (10 + lastPushSeq) || sn < lastPushSeq);
+      if (late) { realtimeStatDrop(REALTIME_MODE_DDP); return; }
     }
   }
 
-  uint32_t start = htonl(p->channelOffset) /3;
-  start += DMXAddress /3;
-  uint16_t stop = start + htons(p->dataLen) /3;
   uint8_t* data = p->data;
-  uint16_t c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  uint16_t dataLen = htons(p->dataLen);
+  uint16_t maxLen = sizeof(p->raw) - DDP_HEADER_LEN;
+  uint32_t tc = 0;
+  if (p->flags & DDP_TIMECODE_FLAG) { //data starts after the 4 byte timecode
+    tc = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+    data += 4;
+    maxLen -= 4;
+  }
+  if (dataLen > maxLen) dataLen = maxLen;
+
+  //32 bit channel offset, a partial leading pixel is skipped
+  uint32_t offset = htonl(p->channelOffset);
+  uint8_t skip = (ch - offset % ch) % ch;
+  uint32_t start = offset / ch + (skip ? 1 : 0) + DMXAddress / ch;
+  uint32_t n = (dataLen > skip) ? (dataLen - skip) / ch : 0;
+  data += skip;
 
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
-  
-  if (!realtimeOverride) {
-    for (uint16_t i = start; i < stop; i++) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], 0);
-      c+=3;
+
+  if (realtimeRoutesActive(REALTIME_MODE_DDP)) {
+    if (!realtimeOverride) routeRealtimeData(findRealtimeRoute(P_DDP, 0), offset, data - skip, dataLen);
+    if (p->flags & DDP_PUSH_FLAG) {
+      byte sn = p->sequenceNum & 0xF;
+      if (sn) ddpLastSequenceNumber = sn;
+      e131NewData = true;
     }
+    return;
   }
 
-  bool push = p->flags & DDP_PUSH_FLAG;
-  if (push) {
-    e131NewData = true;
+  uint16_t totalLen = strip.getLengthTotal();
+  if (!realtimeOverride && n && start < totalLen) {
+    if (n > totalLen - start) n = totalLen - start;
+    if (ch > 1) setRealtimePixels(start, data, n, ch);
+    else { //grayscale, expand to RGB in chunks
+      uint8_t rgb[96*3];
+      for (uint16_t i = 0; i < n; ) {
+        uint16_t c = min((uint16_t)(n - i), (uint16_t)96);
+        for (uint16_t k = 0; k < c; k++) rgb[k*3] = rgb[k*3+1] = rgb[k*3+2] = data[i+k];
+        setRealtimePixels(start + i, rgb, c, 3);
+        i += c;
+      }
+    }
+  }
+
+  if (p->flags & DDP_PUSH_FLAG) {
     byte sn = p->sequenceNum & 0xF;
-    if (sn) e131LastSequenceNumber[0] = sn;
+    if (sn) ddpLastSequenceNumber = sn;
+    ddpPush(tc);
   }
 }
 
@@ -68,12 +441,17 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     dmxChannels = htons(p->property_value_count) -1;
     e131_data = p->property_values;
     seq = p->sequence_number;
+  } else if (protocol == P_E131_SYNC || protocol == P_ARTNET_SYNC) {
+    handleE131Sync(p, protocol);
+    return;
   } else { //DDP
     realtimeIP = clientIP;
-    handleDDPPacket(p);
+    handleDDPPacket(p, clientIP);
     return;
   }
 
+  realtimeStatPacket(mde, dmxChannels);
+
   #ifdef WLED_ENABLE_DMX
   // does not act on out-of-order packets yet
   if (e131ProxyUniverse > 0 && uni == e131ProxyUniverse) {
@@ -83,23 +461,41 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   }
   #endif
 
-  // only listen for universes we're handling & allocated memory
-  if (uni >= (e131Universe + E131_MAX_UNIVERSE_COUNT)) return;
+  //routed universes go straight to their segments, frames are collected like unrouted universes
+  if (realtimeRoutesActive(mde)) {
+    int8_t route = findRealtimeRoute(protocol, uni);
+    if (route < 0) return;
+    realtimeIP = clientIP;
+    realtimeLock(realtimeTimeoutMs, mde);
+    if (realtimeOverride) return;
+    routeRealtimeData(route, 0, e131_data + ((protocol == P_E131) ? 1 : 0), dmxChannels);
+    E131_FRAME_LOCK();
+    handleE131Frame(rtRoutes[route].frame, (protocol == P_E131) ? htons(p->sync_address) : 0);
+    E131_FRAME_UNLOCK();
+    return;
+  }
 
-  uint8_t previousUniverses = uni - e131Universe;
+  // only listen for universes we're handling & allocated memory (tables are sized by the loop)
+  if (uni < e131Universe) return;
+  uint16_t previousUniverses = uni - e131Universe;
+  E131_FRAME_LOCK();
+  if (previousUniverses >= e131Universes) { E131_FRAME_UNLOCK(); return; }
+  byte lastSeq = e131SequenceNumber[previousUniverses];
+  bool skip = e131SkipOutOfSequence && seq < lastSeq && seq > 20 && lastSeq < 250;
+  if (!skip) e131SequenceNumber[previousUniverses] = seq;
+  E131_FRAME_UNLOCK();
 
-  if (e131SkipOutOfSequence)
-    if (seq < e131LastSequenceNumber[uni-e131Universe] && seq > 20 && e131LastSequenceNumber[uni-e131Universe] < 250){
-      DEBUG_PRINT("skipping E1.31 frame (last seq=");
-      DEBUG_PRINT(e131LastSequenceNumber[uni-e131Universe]);
-      DEBUG_PRINT(", current seq=");
-      DEBUG_PRINT(seq);
-      DEBUG_PRINT(", universe=");
-      DEBUG_PRINT(uni);
-      DEBUG_PRINTLN(")");
-      return;
-    }
-  e131LastSequenceNumber[uni-e131Universe] = seq;
+  if (skip) {
+    DEBUG_PRINT("skipping E1.31 frame (last seq=");
+    DEBUG_PRINT(lastSeq);
+    DEBUG_PRINT(", current seq=");
+    DEBUG_PRINT(seq);
+    DEBUG_PRINT(", universe=");
+    DEBUG_PRINT(uni);
+    DEBUG_PRINTLN(")");
+    realtimeStatDrop(mde);
+    return;
+  }
 
   // update status info
   realtimeIP = clientIP;
@@ -124,8 +520,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       realtimeLock(realtimeTimeoutMs, mde);
       if (realtimeOverride) return;
       wChannel = (availDMXLen > 3) ? e131_data[dataOffset+3] : 0;
-      for (uint16_t i = 0; i < totalLen; i++)
-        setRealtimePixel(i, e131_data[dataOffset+0], e131_data[dataOffset+1], e131_data[dataOffset+2], wChannel);
+      fillRealtimePixels(0, totalLen, e131_data[dataOffset+0], e131_data[dataOffset+1], e131_data[dataOffset+2], wChannel);
       break;
 
     case DMX_MODE_SINGLE_DRGB: // Dimmer + RGB
@@ -139,8 +534,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
         bri = e131_data[dataOffset+0];
         strip.setBrightness(bri, true);
       }
-      for (uint16_t i = 0; i < totalLen; i++)
-        setRealtimePixel(i, e131_data[dataOffset+1], e131_data[dataOffset+2], e131_data[dataOffset+3], wChannel);
+      fillRealtimePixels(0, totalLen, e131_data[dataOffset+1], e131_data[dataOffset+2], e131_data[dataOffset+3], wChannel);
       break;
 
     case DMX_MODE_EFFECT: // Length 1: Apply Preset ID, length 11-13: apply effect config
@@ -204,17 +598,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
           previousLeds = ledsInFirstUniverse + (previousUniverses - 1) * ledsPerUniverse;
           ledsTotal = previousLeds + (dmxChannels / dmxChannelsPerLed);
         }
-        if (!is4Chan) {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], 0);
-            dmxOffset+=3;
-          }
-        } else {
-          for (uint16_t i = previousLeds; i < ledsTotal; i++) {
-            setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], e131_data[dmxOffset+3]);
-            dmxOffset+=4;
-          }
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, is4Chan ? 4 : 3);
         break;
       }
     default:
@@ -223,5 +607,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       break;
   }
 
-  e131NewData = true;
+  E131_FRAME_LOCK();
+  handleE131Frame(previousUniverses, (protocol == P_E131) ? htons(p->sync_address) : 0);
+  E131_FRAME_UNLOCK();
 }
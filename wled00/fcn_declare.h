@@ -80,6 +80,17 @@ void handleDMX();
 
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
+void handleE131Sync(e131_packet_t* p, byte protocol);
+void handleE131FrameTimeout();
+uint16_t e131UniverseCount();
+uint16_t e131MulticastUniverses();
+void handleDDPPlayout();
+bool realtimeRoutesActive(byte md);
+bool realtimeRoutesActive();
+void resolveRealtimeRoutes();
+void freezeRealtimeRoutes(bool freeze, bool clear, byte md);
+void deserializeRealtimeRoutes(JsonArray arr);
+void serializeRealtimeRoutes(JsonArray arr);
 
 //file.cpp
 bool handleFileRead(AsyncWebServerRequest*, String path);
@@ -129,14 +140,30 @@ void handleIR();
 #include "FX.h"
 
 void deserializeSegment(JsonObject elem, byte it, byte presetId = 0);
-bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE, byte presetId = 0);
+bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE, byte presetId = 0, JsonDocument* doc = nullptr);
 void serializeSegment(JsonObject& root, WS2812FX::Segment& seg, byte id, bool forPreset = false, bool segmentBounds = true);
-void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true);
-void serializeInfo(JsonObject root);
+void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true, bool segments = true);
+void serializeInfo(JsonObject root, bool usermodInfo = true);
 void serveJson(AsyncWebServerRequest* request);
+bool acceptsMsgPack(AsyncWebServerRequest* request);
+void expireJsonCache();
+struct PixelUpload {
+  uint8_t hdr[PIXEL_UPLOAD_HEADER];
+  uint8_t hdrLen;
+  uint8_t carry[4];  //pixel split between two chunks
+  uint8_t carried;
+  uint16_t pos;      //next pixel, relative to the segment
+  uint16_t count;    //pixels written
+  bool failed;
+};
+bool writePixelUpload(PixelUpload& up, const uint8_t* data, size_t len);
+bool printPixelUploadResult(const PixelUpload& up, char* buf);
 #ifdef WLED_ENABLE_JSONLIVE
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
+#ifdef WLED_ENABLE_RECORDER
+void serveRecording(AsyncWebServerRequest* request);
+#endif
 
 //led.cpp
 void setValuesFromSegment(uint8_t s);
@@ -149,6 +176,8 @@ void applyFinalBri();
 void applyValuesToSelectedSegs();
 void colorUpdated(byte callMode);
 void stateUpdated(byte callMode);
+void handleStateUpdates(bool force = false);
+void serializeStateCoalescing(JsonObject root);
 void updateInterfaces(uint8_t callMode);
 void handleTransitions();
 void handleNightlight();
@@ -198,9 +227,8 @@ void deletePreset(byte index);
 bool isAsterisksOnly(const char* str, byte maxLen);
 void handleSettingsSet(AsyncWebServerRequest *request, byte subPage);
 bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=true);
-int getNumVal(const String* req, uint16_t pos);
 void parseNumber(const char* str, byte* val, byte minv=0, byte maxv=255);
-bool updateVal(const String* req, const char* key, byte* val, byte minv=0, byte maxv=255);
+bool updateVal(const char* str, byte* val, byte minv=0, byte maxv=255);
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
@@ -209,8 +237,19 @@ void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void fillRealtimePixels(uint16_t i, uint16_t n, byte r, byte g, byte b, byte w);
+void setRealtimePixels(uint16_t i, const uint8_t* data, uint16_t n, uint8_t stride);
+void setRealtimeFrameStamp(uint32_t ms);
+bool renderRealtimeFrame();
 void refreshNodeList();
 void sendSysInfoUDP();
+void realtimeStatPacket(byte mode, uint16_t bytes);
+void realtimeStatDrop(byte mode);
+void realtimeStatTorn(byte mode);
+void realtimeStatError(byte mode);
+void realtimeStatFrame(byte mode);
+void serializeRealtimeStats(JsonObject root);
+void sendDDPReply(IPAddress client, uint16_t port, uint8_t id, uint8_t seq);
 
 //util.cpp
 //bool oappend(const char* txt); // append new c string to temp buffer efficiently
@@ -219,8 +258,19 @@ void sendSysInfoUDP();
 //void sappends(char stype, const char* key, char* val);
 //void prepareHostname(char* hostname);
 //bool isAsterisksOnly(const char* str, byte maxLen);
-bool requestJSONBufferLock(uint8_t module=255);
-void releaseJSONBufferLock();
+JsonDocument* requestJSONBuffer(uint8_t module=255, size_t size=JSON_BUFFER_SIZE, uint16_t waitMs=0, bool heapOnly=false);
+void releaseJSONBuffer(JsonDocument* d);
+bool jsonBufferAvailable();
+void serializeJSONPool(JsonObject root);
+void initJSONPool();
+JsonDocument* lockStateApply(JsonDocument* doc);
+void unlockStateApply(JsonDocument* prev);
+JsonDocument* ownJSONBuffer();
+void initRemoteAPI();
+bool applyRemoteJSON(const char* json, size_t len, bool allowPool=false);
+bool applyRemoteSet(const char* req, size_t len);
+void handleRemoteAPI();
+void serializeRemoteAPI(JsonObject root);
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 
 //um_manager.cpp
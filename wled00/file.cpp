@@ -371,6 +371,7 @@ void updateFSInfo() {
     fsBytesUsed  = fsi.usedBytes;
     fsBytesTotal = fsi.totalBytes;
   #endif
+  infoGeneration++;
 }
 
 
@@ -0,0 +1,189 @@
+/*
+ * Palette previews of /json/palx, gzip compressed.
+ */
+
+// Autogenerated from wled00/palettes.h by tools/palettes.js, do not edit!!
+#define JSON_PALX_COUNT 71
+const uint16_t JSON_palx_L = 2879;
+const uint8_t JSON_palx[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xe5, 0x5a, 0x49, 0xae, 0x64, 0xb9,
+  0x0d, 0xbc, 0x4b, 0xae, 0xb9, 0x10, 0x49, 0x8d, 0x75, 0x95, 0x8f, 0x5c, 0x79, 0xdb, 0x36, 0x0c,
+  0x03, 0x5e, 0x35, 0x7c, 0x77, 0x23, 0x38, 0x48, 0x7a, 0xf9, 0x7f, 0xb5, 0x0f, 0x60, 0x54, 0x57,
+  0x56, 0xf2, 0x0d, 0x12, 0x29, 0x92, 0xc1, 0x20, 0xb3, 0xff, 0x7c, 0xfd, 0xfd, 0xf5, 0xab, 0xd0,
+  0xeb, 0x9f, 0xaf, 0x5f, 0x7f, 0xbe, 0xca, 0xeb, 0xd7, 0xd7, 0x57, 0xa1, 0xd9, 0xa8, 0x10, 0x0f,
+  0x7e, 0xd3, 0x17, 0x77, 0x62, 0x15, 0x88, 0x52, 0xdf, 0xf4, 0xa5, 0x42, 0x3c, 0x99, 0x0a, 0x8d,
+  0xf6, 0xa6, 0xaf, 0x3a, 0x49, 0x64, 0x51, 0x21, 0x19, 0x6f, 0xfa, 0xea, 0x95, 0x44, 0x85, 0x44,
+  0xa9, 0xbc, 0xe9, 0x6b, 0x16, 0xe2, 0x59, 0x69, 0xb0, 0x49, 0xab, 0x63, 0x3d, 0x62, 0x5e, 0x26,
+  0x32, 0x8b, 0xcb, 0x71, 0x9b, 0x65, 0xda, 0x77, 0x6c, 0x0c, 0xb1, 0x56, 0x12, 0x61, 0xd2, 0xea,
+  0x62, 0x2f, 0x24, 0xd5, 0x94, 0x80, 0x0e, 0x3c, 0x3a, 0xf1, 0xaa, 0x54, 0xa8, 0x0b, 0xc4, 0x25,
+  0xc4, 0x55, 0x71, 0x97, 0xf5, 0x4d, 0x5f, 0x52, 0x26, 0x2d, 0x33, 0xa0, 0xc3, 0x00, 0x91, 0x4a,
+  0x75, 0x40, 0xc7, 0x32, 0x21, 0xd6, 0x02, 0xed, 0x49, 0xea, 0x7a, 0xbf, 0xe9, 0xc5, 0xaf, 0x5f,
+  0x5f, 0xaf, 0x7f, 0xbd, 0xe8, 0xfa, 0xfb, 0xa6, 0x97, 0xe0, 0xea, 0xdf, 0x18, 0x5f, 0x35, 0xbe,
+  0x52, 0x7c, 0x88, 0x7f, 0xbc, 0xe9, 0x55, 0xed, 0x8e, 0xee, 0x8b, 0xf6, 0x78, 0xfb, 0x78, 0xfc,
+  0xe3, 0x43, 0x7e, 0xf7, 0xa1, 0xbf, 0xfb, 0xb0, 0x55, 0xfb, 0xff, 0x9b, 0x5b, 0x86, 0x1b, 0x8c,
+  0x3f, 0xd2, 0x9a, 0xdb, 0x0b, 0x81, 0x75, 0xb9, 0xb5, 0x47, 0xa8, 0xf3, 0x12, 0x7a, 0xbd, 0x84,
+  0x59, 0x2e, 0x61, 0xdd, 0x0b, 0xc0, 0xce, 0x4b, 0x92, 0x79, 0xef, 0x54, 0xef, 0x35, 0x60, 0x23,
+  0x6b, 0x23, 0x29, 0x9d, 0x44, 0x5b, 0x9a, 0xf9, 0xbc, 0x02, 0x4b, 0x87, 0x92, 0x30, 0xae, 0x94,
+  0xb0, 0x55, 0x5a, 0xcb, 0xbf, 0x61, 0xee, 0xc7, 0x33, 0xf5, 0xb9, 0xf2, 0x9b, 0x5e, 0xf3, 0x58,
+  0x5d, 0xc2, 0xc7, 0xae, 0xda, 0xb1, 0xb9, 0xb8, 0xc5, 0xe7, 0x7a, 0xaf, 0xd0, 0x34, 0x84, 0x59,
+  0x2e, 0x61, 0xdd, 0xaf, 0x9b, 0x67, 0xf7, 0x2d, 0xf3, 0xeb, 0x91, 0xea, 0xbd, 0x86, 0x79, 0xb5,
+  0xb5, 0x94, 0x46, 0x37, 0x89, 0x7b, 0x84, 0xc0, 0x92, 0x4f, 0xcb, 0xc2, 0xd6, 0x7c, 0x02, 0x96,
+  0x9e, 0xf7, 0xdd, 0x4a, 0x5f, 0xfb, 0x4d, 0xaf, 0xe5, 0x16, 0x0a, 0x5e, 0x26, 0x66, 0xf9, 0xc1,
+  0xb3, 0xf7, 0xbd, 0xf4, 0xad, 0xcc, 0xdf, 0xf8, 0x56, 0x4a, 0x73, 0x4b, 0x6b, 0xb7, 0x6d, 0xe6,
+  0xd8, 0xde, 0x35, 0x1b, 0xed, 0x45, 0x7c, 0x5b, 0x8d, 0xb8, 0x4d, 0xe2, 0x5e, 0x2e, 0x17, 0x67,
+  0x68, 0xc5, 0xb2, 0xe9, 0x72, 0x38, 0xb8, 0x20, 0xa8, 0x17, 0x89, 0x8e, 0x74, 0xb0, 0x0c, 0x37,
+  0xda, 0x14, 0x83, 0xd1, 0xf7, 0x96, 0x30, 0xba, 0xdc, 0x87, 0x72, 0x3b, 0xb7, 0x99, 0xe9, 0x5c,
+  0xd2, 0xbb, 0x58, 0xbc, 0xa4, 0xe5, 0x29, 0xa8, 0x20, 0xcb, 0xb8, 0x0c, 0xaa, 0x23, 0x2d, 0xcf,
+  0x7b, 0x66, 0xb9, 0xf9, 0xd2, 0x2d, 0x57, 0xf7, 0x97, 0xd6, 0xf0, 0x72, 0x19, 0xc4, 0x55, 0xc8,
+  0x83, 0x71, 0x1b, 0x9f, 0x8e, 0x7e, 0x1c, 0x0d, 0x5c, 0x5d, 0x04, 0xe7, 0x46, 0x3c, 0xd2, 0xdd,
+  0xcd, 0x0e, 0x92, 0x5a, 0x3a, 0x9c, 0x5b, 0xbd, 0x2e, 0x58, 0x1e, 0x03, 0x43, 0x26, 0xfe, 0x0d,
+  0xe3, 0xd9, 0xbc, 0x2c, 0xdb, 0xe3, 0xcf, 0x45, 0x61, 0xfe, 0x51, 0x12, 0xc6, 0x73, 0x3a, 0xbe,
+  0x9d, 0xe0, 0x16, 0x56, 0xaa, 0x92, 0xd6, 0x5f, 0x38, 0x53, 0x1d, 0x75, 0x70, 0xe4, 0x19, 0xe2,
+  0x17, 0x28, 0xcd, 0x42, 0xd3, 0x5f, 0x2e, 0x99, 0xd7, 0xb6, 0xec, 0x36, 0xde, 0xd7, 0xdd, 0x89,
+  0xed, 0x0b, 0x6f, 0xb7, 0xcf, 0x7e, 0x59, 0x7e, 0x45, 0xc1, 0xe8, 0xa6, 0x0c, 0xde, 0x0e, 0xab,
+  0x2f, 0xb8, 0x75, 0x93, 0x87, 0x9d, 0xec, 0xda, 0xe9, 0x0c, 0xc0, 0x9d, 0xe9, 0x6e, 0x53, 0x88,
+  0xaa, 0x9a, 0xb9, 0xf2, 0x83, 0xb9, 0xe5, 0x64, 0xf2, 0xd3, 0xd6, 0x72, 0xa5, 0xf2, 0xd3, 0xce,
+  0x72, 0x52, 0xf9, 0xd3, 0xc8, 0x93, 0xc8, 0xdf, 0x2c, 0x3c, 0x79, 0xfc, 0x34, 0x6f, 0xdf, 0xf9,
+  0x6e, 0x5b, 0xde, 0xfa, 0xc1, 0xae, 0x92, 0xb9, 0xcb, 0xea, 0x46, 0xb1, 0x9c, 0xa7, 0x89, 0xc7,
+  0x22, 0x71, 0x1f, 0x36, 0x76, 0x1c, 0x28, 0x5e, 0x1d, 0x10, 0xcd, 0x7d, 0xe0, 0x26, 0x5b, 0x12,
+  0x6a, 0xf3, 0x78, 0x26, 0x2e, 0x7e, 0xc0, 0xc8, 0x46, 0x4b, 0x3c, 0x5b, 0xca, 0x4f, 0xca, 0x12,
+  0x14, 0x7b, 0xd5, 0xd8, 0x8b, 0xb8, 0x92, 0xe9, 0x5f, 0x18, 0x8f, 0x6b, 0x8f, 0x5a, 0xd3, 0x1b,
+  0xb5, 0x4e, 0x7d, 0x52, 0x60, 0xa9, 0x10, 0xb7, 0x42, 0xdc, 0x3a, 0xad, 0x15, 0xcb, 0x5d, 0x17,
+  0xb0, 0x62, 0xcb, 0x15, 0x3b, 0x21, 0x13, 0xe6, 0x22, 0xa6, 0xb5, 0x88, 0xd9, 0xca, 0x69, 0x53,
+  0x0f, 0xf2, 0xb2, 0x32, 0x83, 0x4d, 0xa1, 0xa1, 0x34, 0xc5, 0x5e, 0x8f, 0x12, 0x5c, 0x89, 0xc9,
+  0xa2, 0x47, 0x99, 0xb0, 0x87, 0xef, 0xdf, 0xd5, 0x4c, 0xaf, 0xb6, 0xf2, 0x6a, 0xd4, 0x16, 0x09,
+  0x89, 0xd7, 0x96, 0x41, 0xcc, 0xa4, 0x91, 0x4b, 0x6d, 0x11, 0x52, 0x91, 0x1c, 0x86, 0x16, 0x2a,
+  0xaf, 0x10, 0x2f, 0xaa, 0x7e, 0x9c, 0x4a, 0x63, 0xda, 0xe3, 0x69, 0x83, 0xe0, 0xe1, 0xe6, 0x06,
+  0x44, 0x4d, 0xe4, 0x39, 0x0d, 0x5a, 0x38, 0x1e, 0xa9, 0x9d, 0x06, 0xb1, 0x3d, 0x11, 0xf5, 0x43,
+  0xb7, 0xd7, 0xa1, 0xd7, 0x91, 0xa0, 0x4b, 0x1f, 0x47, 0xc4, 0xf6, 0x16, 0xf2, 0x35, 0x0d, 0xce,
+  0x78, 0xc5, 0x62, 0x2b, 0xbd, 0xdd, 0xa1, 0xd1, 0x59, 0x81, 0xd7, 0x20, 0x26, 0xb1, 0xfc, 0x1a,
+  0xc0, 0x43, 0x9c, 0xf2, 0x20, 0x1e, 0x86, 0x8b, 0xc2, 0x26, 0x69, 0x00, 0xb8, 0xfb, 0x21, 0x65,
+  0x30, 0xab, 0x40, 0x41, 0x06, 0x4b, 0x20, 0x16, 0x84, 0x82, 0x76, 0xf8, 0x92, 0x35, 0x43, 0x63,
+  0x0e, 0x82, 0x3f, 0x44, 0x5a, 0x44, 0x35, 0xc0, 0x78, 0x2d, 0x12, 0x1e, 0xd4, 0x2d, 0x96, 0x4a,
+  0x60, 0x71, 0x19, 0xd4, 0x2c, 0x1c, 0xb8, 0x91, 0x54, 0xbc, 0x26, 0xd4, 0x0c, 0xe7, 0xa4, 0x90,
+  0x00, 0xd1, 0xcb, 0x20, 0xa3, 0x1b, 0x48, 0x94, 0xe7, 0x13, 0xb3, 0x3c, 0xd7, 0xc0, 0xe9, 0xdb,
+  0x05, 0x19, 0x54, 0xe7, 0x75, 0x20, 0x52, 0x27, 0xe0, 0x04, 0xca, 0x07, 0x8a, 0x31, 0x17, 0xaa,
+  0x08, 0x1d, 0x3c, 0xb5, 0x10, 0x07, 0x00, 0x3b, 0x0b, 0x04, 0x30, 0x2f, 0xfc, 0xb7, 0x42, 0x80,
+  0x0e, 0x52, 0x09, 0xeb, 0x2d, 0x24, 0x83, 0x87, 0xa4, 0xb8, 0x8e, 0x88, 0x37, 0x25, 0x5e, 0x1a,
+  0x3a, 0x8e, 0x49, 0xaa, 0xd4, 0x94, 0x5a, 0xdf, 0x11, 0xc8, 0xd4, 0x7c, 0xef, 0x0b, 0x52, 0x00,
+  0xbc, 0xe2, 0x79, 0x20, 0x1f, 0x17, 0xe4, 0xdb, 0x05, 0x90, 0x32, 0x9c, 0x1f, 0x62, 0xcd, 0xfc,
+  0x8c, 0xf0, 0x41, 0xc1, 0xb0, 0x95, 0x5d, 0xce, 0x65, 0xac, 0x9a, 0xb6, 0x42, 0x48, 0xe5, 0xda,
+  0x63, 0x05, 0x83, 0x24, 0x50, 0x14, 0x12, 0x81, 0x5e, 0x4b, 0x49, 0x4c, 0x69, 0x5e, 0x2b, 0x8e,
+  0xda, 0xad, 0xe2, 0x61, 0x2a, 0xa9, 0x22, 0x6d, 0x4b, 0xee, 0xc7, 0xc8, 0x59, 0x64, 0x84, 0xf3,
+  0x56, 0xb5, 0x70, 0x55, 0xce, 0x4a, 0x01, 0x60, 0x25, 0x28, 0xd8, 0x78, 0xdb, 0x6c, 0xd1, 0x60,
+  0x40, 0x2a, 0x7a, 0xd2, 0x8e, 0x1d, 0x63, 0x1c, 0x34, 0xa0, 0x57, 0x27, 0x84, 0x62, 0xa9, 0xa4,
+  0x01, 0x10, 0x16, 0x6d, 0x58, 0x7a, 0x9d, 0x68, 0x5f, 0x54, 0x33, 0xbf, 0xf3, 0x45, 0x70, 0xe3,
+  0x5c, 0xd0, 0xd3, 0x96, 0x3d, 0x81, 0x24, 0x50, 0x67, 0x92, 0xd7, 0x96, 0x6a, 0xac, 0x39, 0x8a,
+  0x90, 0xd2, 0x68, 0xa4, 0x93, 0x70, 0x04, 0xb3, 0x12, 0xf7, 0x05, 0xf8, 0x50, 0x8f, 0x47, 0xaf,
+  0x47, 0xb8, 0xc6, 0xbe, 0x39, 0xf7, 0x0f, 0x9a, 0xc4, 0xea, 0x69, 0xeb, 0x3a, 0xda, 0x5b, 0xd5,
+  0x83, 0xc5, 0x42, 0xcc, 0xdc, 0x5f, 0x6e, 0x94, 0x5f, 0x6c, 0xe0, 0xd8, 0x1d, 0x69, 0x0d, 0xf3,
+  0xe3, 0x56, 0x1c, 0x52, 0xf3, 0x44, 0x95, 0xf6, 0x64, 0x8d, 0x3a, 0xc8, 0x48, 0x54, 0x1c, 0x11,
+  0x83, 0x4b, 0x35, 0xca, 0xec, 0x05, 0x5c, 0x43, 0xd3, 0x24, 0x81, 0x02, 0xcd, 0xd9, 0x39, 0x87,
+  0x65, 0xe0, 0x9c, 0x0e, 0x82, 0x7e, 0x25, 0x60, 0x91, 0xa7, 0x44, 0x70, 0x48, 0xa9, 0xf0, 0x25,
+  0x23, 0x22, 0x5a, 0x2a, 0xc3, 0x84, 0x80, 0x5a, 0x1e, 0xa7, 0x3d, 0x71, 0x36, 0xed, 0x20, 0x6f,
+  0x3e, 0xb0, 0x25, 0xce, 0xa0, 0x3b, 0x70, 0x06, 0x3a, 0xc9, 0xf2, 0x0d, 0x20, 0x76, 0x60, 0x23,
+  0x10, 0xc9, 0xe2, 0xc8, 0x17, 0xae, 0xe1, 0x99, 0x71, 0xa2, 0x5f, 0xd5, 0x5c, 0x5a, 0x3d, 0x5d,
+  0x91, 0x64, 0x50, 0x6c, 0xfa, 0x81, 0x0f, 0x97, 0x92, 0xad, 0x4d, 0xc9, 0x72, 0x33, 0xca, 0x71,
+  0x48, 0x75, 0x0a, 0xb7, 0x50, 0xf0, 0x3d, 0xe5, 0x63, 0xbf, 0xe9, 0x6f, 0x75, 0x63, 0xe3, 0x12,
+  0x70, 0x6a, 0xb0, 0x01, 0x1a, 0x9c, 0xc4, 0xcc, 0x5d, 0xd8, 0xc3, 0xb1, 0x73, 0x59, 0x5a, 0xcb,
+  0x8a, 0xf4, 0x40, 0xdd, 0x1d, 0xb6, 0xf1, 0x30, 0x14, 0x01, 0x8b, 0x37, 0x0c, 0xe0, 0xb2, 0x2b,
+  0xd3, 0x96, 0xb1, 0xcd, 0xda, 0xa5, 0x6e, 0x3f, 0xd4, 0xf1, 0xce, 0x52, 0x1a, 0x16, 0x4b, 0x38,
+  0x72, 0xa1, 0xee, 0x87, 0x66, 0x4e, 0x82, 0x53, 0x01, 0xc5, 0xe6, 0xa2, 0x72, 0xdd, 0x15, 0xa4,
+  0x1d, 0x28, 0x8e, 0xa3, 0xb1, 0x11, 0x6f, 0x44, 0x78, 0xbb, 0xc3, 0xa6, 0x9a, 0x79, 0x1a, 0x48,
+  0x5c, 0x07, 0x69, 0x21, 0x89, 0x70, 0x47, 0x6c, 0xd4, 0xe1, 0x01, 0x89, 0x28, 0x2f, 0x68, 0x59,
+  0x96, 0x23, 0x05, 0xb6, 0x74, 0x51, 0xca, 0x88, 0x33, 0x65, 0xc2, 0x81, 0x38, 0xd2, 0xa0, 0x94,
+  0xe1, 0x0f, 0xf3, 0xb6, 0x73, 0x90, 0xe7, 0xb1, 0x26, 0x72, 0xae, 0x4c, 0x3c, 0xfb, 0x02, 0xef,
+  0x3b, 0x39, 0x00, 0x2a, 0x5b, 0xee, 0x4a, 0x42, 0x2f, 0xb3, 0x66, 0x5e, 0x6a, 0x62, 0x5f, 0xa2,
+  0x80, 0x12, 0x03, 0x36, 0x4a, 0x9c, 0x4e, 0x5f, 0xb6, 0xd2, 0xce, 0xf3, 0xe1, 0x05, 0xb2, 0x9c,
+  0x0a, 0xd9, 0x3a, 0x19, 0x0f, 0xd5, 0xe4, 0x30, 0xac, 0x64, 0xe5, 0x0f, 0x76, 0x0c, 0xb1, 0x1a,
+  0x35, 0x27, 0x99, 0xc7, 0xe0, 0xd0, 0x32, 0xc1, 0x90, 0x54, 0xef, 0x62, 0x13, 0x80, 0x0f, 0xe0,
+  0x04, 0x80, 0xea, 0x55, 0xa6, 0x51, 0xd6, 0x95, 0xa6, 0xf9, 0x53, 0xeb, 0xe6, 0xf9, 0xa7, 0x0a,
+  0x2b, 0xe2, 0xb4, 0xee, 0xc8, 0xd4, 0x47, 0x9a, 0xa3, 0xbe, 0xf5, 0xb9, 0xe1, 0x28, 0x02, 0xdf,
+  0xd6, 0xfa, 0xc8, 0x6d, 0x50, 0xf9, 0x79, 0xb5, 0x77, 0x46, 0x39, 0xfd, 0x14, 0xa6, 0xb7, 0x00,
+  0x7e, 0x0a, 0xbc, 0x08, 0xb5, 0x99, 0x23, 0x44, 0x6a, 0x70, 0xed, 0x4a, 0x5e, 0xb5, 0x6b, 0xe6,
+  0x86, 0xc1, 0xce, 0x8c, 0x88, 0xe6, 0x46, 0xce, 0xee, 0x3d, 0x29, 0xd8, 0xce, 0x0c, 0x6e, 0x8d,
+  0x5e, 0xb6, 0x78, 0xde, 0x89, 0xd6, 0x9d, 0x49, 0x26, 0xd7, 0x23, 0x8f, 0xdb, 0x86, 0xc4, 0x3e,
+  0xd8, 0xd1, 0x9f, 0x76, 0x34, 0xc4, 0xe5, 0x8a, 0x03, 0xc1, 0xec, 0x01, 0xc0, 0x9a, 0xed, 0xf7,
+  0x82, 0x15, 0x65, 0xb3, 0x14, 0xd4, 0x69, 0xf5, 0xfa, 0xef, 0xc4, 0x0c, 0x56, 0xe1, 0xb6, 0xb6,
+  0x8b, 0xaa, 0x7d, 0x6e, 0x38, 0x36, 0xcd, 0x98, 0x0e, 0x7e, 0xe2, 0x1e, 0x2c, 0x11, 0x71, 0xe8,
+  0x7a, 0xd0, 0xf0, 0x4d, 0xef, 0x14, 0x96, 0xd2, 0x54, 0xe0, 0xb9, 0x07, 0x7a, 0xe9, 0x56, 0xe3,
+  0x7b, 0xa7, 0x6e, 0x47, 0x84, 0xb7, 0x44, 0x51, 0xf3, 0xbb, 0xab, 0xac, 0xde, 0xdb, 0x34, 0xea,
+  0x3d, 0xd0, 0xde, 0xda, 0x24, 0x1e, 0xb4, 0x66, 0x96, 0xf6, 0x74, 0xa5, 0xb7, 0x90, 0x70, 0x30,
+  0x78, 0x0c, 0x5a, 0xf4, 0xa3, 0x35, 0x28, 0x10, 0x5b, 0xe1, 0x84, 0xd2, 0x33, 0x93, 0x84, 0x24,
+  0x63, 0x8b, 0xa4, 0x53, 0xf5, 0x83, 0x6a, 0x8c, 0x20, 0xeb, 0xae, 0xe2, 0x30, 0xf2, 0x6b, 0x14,
+  0xca, 0x29, 0x12, 0x76, 0x9f, 0xc4, 0x40, 0xb0, 0x5a, 0x52, 0x67, 0x20, 0xac, 0x53, 0x23, 0xd3,
+  0xb2, 0x1a, 0x85, 0x0a, 0x87, 0x99, 0x9a, 0x88, 0xfc, 0xe5, 0x9d, 0xae, 0x70, 0x9c, 0x3e, 0xac,
+  0x03, 0x0d, 0x9d, 0x66, 0xc9, 0x54, 0x6b, 0x26, 0x91, 0x9d, 0x5b, 0x6d, 0x04, 0x14, 0x1a, 0x5c,
+  0xf1, 0xdc, 0xce, 0xa6, 0xbe, 0x9f, 0x22, 0xdd, 0x07, 0x39, 0xa8, 0x03, 0x43, 0xa0, 0x97, 0x4b,
+  0x48, 0x56, 0x23, 0x1f, 0x60, 0x61, 0x92, 0x63, 0x09, 0xd6, 0x0d, 0x6e, 0x50, 0x08, 0xfc, 0xa1,
+  0x2e, 0xb0, 0x5e, 0x3f, 0xc8, 0xe7, 0x0b, 0xda, 0x1e, 0x2f, 0x54, 0x1f, 0x6b, 0xa0, 0x63, 0xad,
+  0x8e, 0xbe, 0xea, 0xc8, 0xa1, 0x81, 0x87, 0xd5, 0xe8, 0x99, 0x0b, 0x30, 0x6e, 0x5c, 0x85, 0x3f,
+  0x04, 0xcc, 0xf2, 0xca, 0x47, 0xa2, 0x79, 0x8b, 0x65, 0xe7, 0x3e, 0x1f, 0xc3, 0x02, 0xb0, 0x43,
+  0xb9, 0xda, 0xaa, 0x6c, 0xf2, 0x32, 0x38, 0x3d, 0x79, 0xda, 0x5f, 0xc4, 0x66, 0xe5, 0xe7, 0x5e,
+  0xdd, 0xbb, 0xe0, 0x0b, 0x1e, 0xae, 0x05, 0x81, 0x0f, 0x2e, 0xff, 0x44, 0xd2, 0xab, 0x7c, 0x53,
+  0xdb, 0x35, 0x77, 0xb5, 0xaf, 0xf6, 0x73, 0x2f, 0x5b, 0xff, 0x87, 0xda, 0xf5, 0x53, 0x6b, 0xdf,
+  0x48, 0x3f, 0x07, 0x72, 0x5d, 0xbd, 0x98, 0x9c, 0x63, 0xb9, 0xe7, 0x1f, 0x50, 0x3b, 0x8a, 0xeb,
+  0x6f, 0x16, 0x3c, 0x28, 0xd9, 0x0a, 0x2d, 0xb8, 0xd6, 0xe9, 0x6e, 0x4a, 0xe2, 0x08, 0x40, 0x43,
+  0x36, 0xe7, 0xd9, 0x22, 0xde, 0xdf, 0xed, 0x9c, 0x78, 0x47, 0xf8, 0x8f, 0x7f, 0xff, 0xf1, 0x07,
+  0x09, 0x35, 0x9f, 0x82, 0x98, 0xd4, 0x99, 0xec, 0x5f, 0x6f, 0xe8, 0xb5, 0xd1, 0x12, 0xbf, 0xe0,
+  0x04, 0xc0, 0xbe, 0x06, 0x8b, 0xe0, 0xa5, 0x7b, 0x8d, 0xd6, 0xf2, 0x29, 0x2b, 0x0e, 0x18, 0x49,
+  0xfa, 0x85, 0xbe, 0xf2, 0x19, 0x63, 0xbf, 0x23, 0x46, 0x97, 0x76, 0x65, 0x75, 0x7f, 0x46, 0x4f,
+  0xf7, 0x59, 0xfd, 0xca, 0x18, 0xa6, 0xef, 0x45, 0x8b, 0xea, 0xd6, 0x70, 0x4b, 0xd2, 0xa8, 0x39,
+  0x7d, 0x1c, 0xdf, 0x6f, 0x76, 0x3e, 0xdf, 0x31, 0xa5, 0x68, 0x06, 0xee, 0xca, 0xdf, 0x1e, 0xb4,
+  0x6c, 0xda, 0x82, 0xb8, 0xea, 0x46, 0x10, 0xbe, 0x3f, 0xda, 0xef, 0x47, 0x87, 0x43, 0xfc, 0xf2,
+  0xb3, 0xfe, 0x50, 0x0d, 0xb9, 0xbb, 0x05, 0xa3, 0x39, 0x0a, 0x1d, 0x86, 0xfc, 0x60, 0x45, 0x4b,
+  0x01, 0x26, 0x5f, 0x9c, 0x6d, 0x35, 0xf2, 0x56, 0xaf, 0x64, 0xe9, 0x29, 0x0e, 0xc2, 0x58, 0x8c,
+  0xd5, 0xfb, 0xa3, 0x62, 0x54, 0x30, 0xab, 0x94, 0x94, 0x28, 0x4b, 0x98, 0x53, 0x04, 0xd1, 0x31,
+  0x72, 0x16, 0xa3, 0x6a, 0x03, 0xd2, 0x69, 0x89, 0x6e, 0xf9, 0xcc, 0x60, 0x6a, 0xec, 0xc4, 0x2b,
+  0x03, 0x86, 0x15, 0xcc, 0xd4, 0xc0, 0xb5, 0x26, 0xb8, 0xce, 0x4a, 0xf5, 0x32, 0x73, 0x8b, 0x40,
+  0x94, 0xb3, 0xbd, 0xdf, 0xbc, 0xd4, 0x51, 0x34, 0x21, 0xab, 0x9f, 0x9b, 0x5b, 0xe2, 0x05, 0xda,
+  0x09, 0xfe, 0x90, 0xb7, 0x42, 0xc2, 0xae, 0x49, 0xee, 0x50, 0xad, 0x57, 0xf4, 0x88, 0x2d, 0xed,
+  0xf0, 0xc3, 0xd7, 0xf2, 0x38, 0x52, 0x2c, 0xf7, 0xa0, 0xae, 0x5e, 0x28, 0x1c, 0xd2, 0x2c, 0x96,
+  0x5a, 0xf9, 0x29, 0x96, 0x30, 0xc3, 0x2b, 0x7e, 0xca, 0x3e, 0x15, 0x4a, 0x8a, 0x91, 0x77, 0xab,
+  0x86, 0x97, 0x7c, 0x0a, 0xa3, 0x8d, 0xc6, 0x37, 0x9f, 0xb5, 0x8d, 0x4d, 0xde, 0x16, 0xe6, 0xeb,
+  0x2a, 0x66, 0x6d, 0x6b, 0x3f, 0xac, 0x67, 0x73, 0x16, 0x81, 0x8b, 0xa7, 0x9c, 0x24, 0xb2, 0xae,
+  0x73, 0xed, 0xe7, 0x51, 0x2e, 0x46, 0xa1, 0x69, 0xc9, 0xdb, 0x02, 0xb6, 0xba, 0xf7, 0x1f, 0x3b,
+  0x5f, 0xb7, 0x58, 0xd1, 0x94, 0x19, 0xd1, 0xad, 0xe7, 0xb8, 0xb7, 0xbc, 0xdc, 0xb6, 0xcb, 0xba,
+  0x23, 0x5a, 0x7d, 0x58, 0x1d, 0xf5, 0xea, 0xb8, 0xf1, 0xc8, 0x16, 0x35, 0x3a, 0x40, 0x0a, 0xce,
+  0xed, 0x94, 0xa1, 0x99, 0x9e, 0x98, 0xfd, 0x71, 0xfd, 0x5e, 0xfe, 0x72, 0x79, 0xf9, 0x0b, 0xa3,
+  0xb0, 0xf7, 0x6f, 0xad, 0xc2, 0xde, 0x7b, 0xe6, 0x05, 0x6a, 0x5f, 0x9c, 0x0c, 0x81, 0x09, 0xe2,
+  0x78, 0x47, 0x74, 0xea, 0x04, 0xce, 0x6d, 0x43, 0x10, 0x54, 0x3e, 0x64, 0x2c, 0x2f, 0xdc, 0x6b,
+  0x56, 0x7c, 0x39, 0xeb, 0xf8, 0xc0, 0x14, 0xc8, 0x5a, 0x85, 0x16, 0x55, 0x18, 0x01, 0x84, 0x87,
+  0xaa, 0xfd, 0x18, 0xb2, 0x50, 0xa1, 0xd1, 0xd5, 0xc5, 0x0c, 0x1e, 0xb1, 0x25, 0x4c, 0x68, 0x1f,
+  0x36, 0xd5, 0x47, 0x6d, 0xb5, 0xf9, 0x44, 0xb2, 0x5e, 0x9b, 0xec, 0x47, 0x27, 0xc7, 0x31, 0x64,
+  0x30, 0xc2, 0x91, 0x15, 0x05, 0x8d, 0x52, 0x0d, 0xce, 0x69, 0x5b, 0x0e, 0x74, 0x54, 0x1c, 0xd3,
+  0x3e, 0x6b, 0xbb, 0xa3, 0x12, 0x8b, 0xff, 0xee, 0x24, 0xf6, 0x2e, 0xa6, 0x8c, 0x98, 0x6a, 0x53,
+  0x46, 0x7b, 0x08, 0x38, 0x93, 0x84, 0x79, 0xb4, 0x60, 0xc3, 0x91, 0xdc, 0x0f, 0x1d, 0xda, 0x56,
+  0x39, 0xc8, 0x86, 0x88, 0x1b, 0x66, 0xc5, 0xb9, 0x52, 0x08, 0xef, 0xd8, 0xd9, 0xf9, 0x4b, 0xc3,
+  0x07, 0x13, 0x10, 0x6c, 0xf5, 0x00, 0x65, 0xb1, 0x03, 0x67, 0x9f, 0x23, 0x60, 0x2b, 0x34, 0x27,
+  0xd3, 0xc7, 0x08, 0x81, 0x8b, 0x33, 0xfb, 0xdb, 0x96, 0xa8, 0x66, 0x48, 0x98, 0x3d, 0xd8, 0x73,
+  0x09, 0x94, 0x61, 0xf8, 0x71, 0x96, 0x1c, 0x74, 0x82, 0x68, 0x8c, 0x75, 0xcd, 0x39, 0x23, 0xdd,
+  0xe6, 0x76, 0xb9, 0x30, 0xb5, 0xb4, 0x7f, 0xa0, 0x61, 0x40, 0xfb, 0x88, 0x47, 0xd6, 0xc1, 0x2d,
+  0xce, 0x1f, 0x34, 0xba, 0xb5, 0x8b, 0x28, 0x42, 0x96, 0x72, 0x68, 0xc9, 0x7c, 0x62, 0x06, 0xdd,
+  0xcb, 0xcf, 0xb4, 0xa3, 0x7f, 0x50, 0x9c, 0xe8, 0xd6, 0xd4, 0xfb, 0xa9, 0x99, 0x33, 0x3d, 0x0b,
+  0xd2, 0x8e, 0x5e, 0xc6, 0xa9, 0xb9, 0xff, 0x20, 0xc3, 0xc6, 0xad, 0x00, 0x51, 0xa0, 0xd4, 0x3e,
+  0xf7, 0x99, 0x36, 0x5c, 0x10, 0x2f, 0x44, 0xa2, 0x36, 0x15, 0xa2, 0x76, 0xd9, 0x68, 0xb9, 0xde,
+  0xf9, 0x9e, 0x5b, 0x25, 0x3f, 0xf0, 0x95, 0x24, 0xd9, 0x02, 0xbe, 0x89, 0x91, 0x31, 0x19, 0x3f,
+  0xc9, 0xf5, 0xf3, 0x7d, 0x8e, 0x41, 0xdd, 0x7e, 0x62, 0x79, 0x5d, 0x3c, 0xd3, 0xdf, 0x4f, 0xeb,
+  0x25, 0x67, 0xa3, 0x68, 0x84, 0x34, 0xb8, 0x28, 0x68, 0x2e, 0x02, 0xdb, 0x19, 0x73, 0x34, 0x42,
+  0xe5, 0x10, 0x8e, 0x99, 0xfc, 0xb0, 0xeb, 0x07, 0x67, 0xf3, 0x94, 0xb7, 0x5e, 0x4e, 0xbd, 0x19,
+  0xcb, 0x0d, 0x3f, 0xf9, 0x7f, 0x2a, 0xac, 0xcf, 0x27, 0xe6, 0x7c, 0xae, 0xf0, 0x3c, 0xb4, 0x9a,
+  0x63, 0x2f, 0x9f, 0x24, 0xb6, 0x98, 0x95, 0x3b, 0x8f, 0xc7, 0xd0, 0xc8, 0x7e, 0x11, 0x32, 0xa7,
+  0x34, 0xfb, 0x59, 0x86, 0xa2, 0xff, 0x05, 0x5d, 0x1f, 0xcb, 0xce, 0x22, 0x02, 0xc3, 0x66, 0x8e,
+  0xec, 0x55, 0xcc, 0x34, 0x50, 0xcf, 0x4c, 0xb7, 0xeb, 0xa3, 0xc1, 0x5c, 0xde, 0xc1, 0xc3, 0x43,
+  0x85, 0x80, 0x79, 0x3d, 0x8c, 0x8d, 0xaf, 0x36, 0xd6, 0xf3, 0x59, 0xc5, 0x37, 0x9d, 0x3f, 0x7a,
+  0xbc, 0xb5, 0xd2, 0x43, 0x59, 0xe4, 0x40, 0x46, 0xd6, 0xf2, 0xa2, 0x70, 0x39, 0xf0, 0xdb, 0x42,
+  0x63, 0x0f, 0x44, 0x5c, 0x13, 0xf5, 0x09, 0x5d, 0x0e, 0xb4, 0x4a, 0x44, 0xad, 0x77, 0x38, 0x18,
+  0x11, 0xed, 0x49, 0xbb, 0x9d, 0x6e, 0x8f, 0xb1, 0x32, 0x7e, 0x23, 0x60, 0xc0, 0x42, 0x8f, 0x9f,
+  0xfd, 0xd0, 0x0c, 0xa0, 0x3c, 0x20, 0x51, 0xf2, 0xc8, 0xd1, 0xdc, 0xa2, 0x23, 0xc4, 0xbe, 0x39,
+  0x3e, 0x67, 0x83, 0x60, 0x8f, 0x52, 0xb5, 0xad, 0xbb, 0xdb, 0x83, 0x4a, 0xd1, 0xcc, 0x21, 0x18,
+  0x58, 0xd8, 0xac, 0x04, 0x21, 0x52, 0x62, 0x14, 0x6e, 0x3d, 0xaa, 0x9c, 0x39, 0x0c, 0x6c, 0xa5,
+  0xbe, 0x6b, 0x6c, 0x89, 0x23, 0x5f, 0x67, 0xac, 0x14, 0xf3, 0x3c, 0x8f, 0xbb, 0x3e, 0xd2, 0x5c,
+  0xb8, 0x08, 0x53, 0x7e, 0x76, 0xd7, 0x43, 0xc4, 0x00, 0x6a, 0x43, 0x39, 0xa0, 0x67, 0x46, 0xa7,
+  0x5f, 0xbd, 0xdd, 0x91, 0x68, 0x87, 0x22, 0x51, 0xa4, 0x51, 0xad, 0xd9, 0x76, 0x5e, 0xf7, 0x11,
+  0xa7, 0xf1, 0x33, 0xc7, 0xcc, 0xe9, 0x54, 0x46, 0x7a, 0xce, 0x32, 0xf6, 0xd8, 0x65, 0x04, 0x62,
+  0xa8, 0x4d, 0x37, 0xd4, 0x87, 0x72, 0x86, 0x0e, 0x1c, 0xff, 0x97, 0x41, 0x5d, 0x3e, 0xf7, 0x82,
+  0x67, 0x94, 0xf2, 0x37, 0x6e, 0x8e, 0x9f, 0x57, 0xc6, 0xc0, 0x71, 0xb7, 0xcd, 0x9e, 0xe2, 0x3d,
+  0x8e, 0x5f, 0x4b, 0xa0, 0x7b, 0x0f, 0x20, 0xb9, 0x5f, 0x15, 0xfb, 0x01, 0xe4, 0xda, 0xb2, 0x45,
+  0x28, 0xbc, 0xff, 0xf3, 0x9f, 0xff, 0x02, 0x93, 0xab, 0xb9, 0xc3, 0xad, 0x22, 0x00, 0x00
+};
@@ -640,7 +640,9 @@ void decodeIRJson(uint32_t code)
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(13)) return;
+  JsonDocument* pDoc = requestJSONBuffer(13);
+  if (!pDoc) return;
+  JsonDocument& doc = *pDoc;
   #endif
 
   sprintf_P(objKey, PSTR("\"0x%lX\":"), (unsigned long)code);
@@ -655,7 +657,7 @@ void decodeIRJson(uint32_t code)
   if (fdo.isNull()) {
     //the received code does not exist
     if (!WLED_FS.exists("/ir.json")) errorFlag = ERR_FS_IRLOAD; //warn if IR file itself doesn't exist
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
     return;
   }
 
@@ -693,7 +695,7 @@ void decodeIRJson(uint32_t code)
     }
   } else {
     // command is JSON object (TODO: currently will not handle irApplyToAllSelected correctly)
-    if (jsonCmdObj[F("psave")].isNull()) deserializeState(jsonCmdObj, CALL_MODE_BUTTON_PRESET);
+    if (jsonCmdObj[F("psave")].isNull()) deserializeState(jsonCmdObj, CALL_MODE_BUTTON_PRESET, 0, &doc);
     else {
       uint8_t psave = jsonCmdObj[F("psave")].as<int>();
       char pname[33];
@@ -702,7 +704,7 @@ void decodeIRJson(uint32_t code)
       if (psave > 0 && psave < 251) savePreset(psave, pname, fdo);
     }
   }
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
 }
 
 void initIR()
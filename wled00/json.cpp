@@ -215,13 +215,10 @@ void deserializeSegment(JsonObject elem, byte it, byte presetId)
         }
 
         if (set < 2) stop = start + 1;
-        for (uint16_t i = start; i < stop; i++) {
-          if (strip.gammaCorrectCol) {
-            strip.setPixelColor(i, strip.gamma8(rgbw[0]), strip.gamma8(rgbw[1]), strip.gamma8(rgbw[2]), strip.gamma8(rgbw[3]));
-          } else {
-            strip.setPixelColor(i, rgbw[0], rgbw[1], rgbw[2], rgbw[3]);
-          }
+        if (strip.gammaCorrectCol) {
+          for (uint8_t c = 0; c < 4; c++) rgbw[c] = strip.gamma8(rgbw[c]);
         }
+        if (stop > start) strip.fillSpan(start, stop - start, RGBW32(rgbw[0], rgbw[1], rgbw[2], rgbw[3]));
         if (!set) start++;
         set = 0;
       }
@@ -235,11 +232,90 @@ void deserializeSegment(JsonObject elem, byte it, byte presetId)
   //if (!presetId && (seg.differs(prev) & 0x7F)) stateChanged = true;
   // send UDP if something changed that is not just selection
   if (seg.differs(prev) & 0x7F) stateChanged = true;
+  stateGeneration++;
   return;
 }
 
-// deserializes WLED state (fileDoc points to doc object if called from web server)
-bool deserializeState(JsonObject root, byte callMode, byte presetId)
+/*
+ * Binary pixel upload, the bulk alternative to the "i" array: a PIXEL_UPLOAD_HEADER of 'P', segment id,
+ * start pixel (big endian) and bytes per pixel (3 RGB, 4 RGBW), followed by raw pixel data.
+ * Data may arrive in chunks split anywhere, every chunk is written into the (frozen) segment right away.
+ * Returns false if the header is invalid, the upload is ignored from then on.
+ */
+bool writePixelUpload(PixelUpload& up, const uint8_t* data, size_t len)
+{
+  if (up.failed) return false;
+  bool started = up.hdrLen == PIXEL_UPLOAD_HEADER;
+  while (up.hdrLen < PIXEL_UPLOAD_HEADER && len) { up.hdr[up.hdrLen++] = *data++; len--; }
+  if (up.hdrLen < PIXEL_UPLOAD_HEADER) return true;
+
+  uint8_t id = up.hdr[1], stride = up.hdr[4];
+  if (up.hdr[0] != PIXEL_UPLOAD_MAGIC || id >= strip.getMaxSegments() || (stride != 3 && stride != 4)
+      || !strip.getSegment(id).isActive()) {
+    up.failed = true;
+    return false;
+  }
+  WS2812FX::Segment& seg = strip.getSegment(id);
+  uint8_t oldSegId = strip.setPixelSegment(id);
+
+  if (!started) { //same as "i"
+    up.pos = (up.hdr[2] << 8) | up.hdr[3];
+    transitionDelayTemp = 0;
+    jsonTransitionOnce = true;
+    strip.setBrightness(scaledBri(bri), true);
+    if (!seg.getOption(SEG_OPTION_FREEZE)) {
+      seg.setOption(SEG_OPTION_FREEZE, true);
+      strip.fill(0);
+      stateGeneration++;
+    }
+  }
+
+  uint16_t segLen = seg.virtualLength();
+  const uint8_t* lut = strip.gammaCorrectCol ? strip.getGammaTable() : nullptr;
+  if (up.carried) { //complete the pixel split off the last chunk
+    while (up.carried < stride && len) { up.carry[up.carried++] = *data++; len--; }
+    if (up.carried == stride) {
+      if (up.pos < segLen) { strip.writeSpan(up.pos, up.carry, 1, stride, lut); up.count++; }
+      up.pos++;
+      up.carried = 0;
+    }
+  }
+  uint16_t n = len / stride;
+  uint16_t w = (up.pos < segLen) ? min(n, (uint16_t)(segLen - up.pos)) : 0; //pixels past the segment end are dropped
+  if (w) strip.writeSpan(up.pos, data, w, stride, lut);
+  up.pos += n; up.count += w;
+  data += n * stride; len -= n * stride;
+  memcpy(up.carry, data, len);
+  up.carried = len;
+
+  strip.setPixelSegment(oldSegId);
+  strip.trigger();
+  return true;
+}
+
+//acknowledgement of a finished upload, buf needs 40 bytes, false if it failed
+bool printPixelUploadResult(const PixelUpload& up, char* buf)
+{
+  if (up.failed || up.hdrLen < PIXEL_UPLOAD_HEADER) {
+    sprintf_P(buf, PSTR("{\"error\":%u}"), ERR_JSON);
+    return false;
+  }
+  sprintf_P(buf, PSTR("{\"success\":true,\"n\":%u}"), up.count);
+  return true;
+}
+
+static bool deserializeStateLocked(JsonObject root, byte callMode, byte presetId);
+
+// deserializes WLED state, doc is the document root belongs to and is reused by presets (see ownJSONBuffer())
+bool deserializeState(JsonObject root, byte callMode, byte presetId, JsonDocument* doc)
+{
+  JsonDocument* prev = lockStateApply(doc);
+  bool stateResponse = deserializeStateLocked(root, callMode, presetId);
+  unlockStateApply(prev);
+  return stateResponse;
+}
+
+static bool deserializeStateLocked(JsonObject root, byte callMode, byte presetId)
 {
   bool stateResponse = root[F("v")] | false;
 
@@ -255,7 +331,9 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
     for (uint8_t s=0; s < strip.getMaxSegments(); s++) {
       strip.getSegment(s).setOption(SEG_OPTION_FREEZE, false, s);
     }
-    if (realtimeMode && !realtimeOverride && useMainSegmentOnly) { // keep live segment frozen if live
+    if (realtimeMode && !realtimeOverride && realtimeRoutesActive()) { // keep routed segments frozen if live
+      freezeRealtimeRoutes(true, false, realtimeMode);
+    } else if (realtimeMode && !realtimeOverride && useMainSegmentOnly) { // keep live segment frozen if live
       strip.getMainSegment().setOption(SEG_OPTION_FREEZE, true, strip.getMainSegmentId());
     }
   }
@@ -306,7 +384,9 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
 
   realtimeOverride = root[F("lor")] | realtimeOverride;
   if (realtimeOverride > 2) realtimeOverride = REALTIME_OVERRIDE_ALWAYS;
-  if (realtimeMode && useMainSegmentOnly) {
+  if (realtimeMode && realtimeRoutesActive()) {
+    freezeRealtimeRoutes(!realtimeOverride, false, realtimeMode);
+  } else if (realtimeMode && useMainSegmentOnly) {
     strip.getMainSegment().setOption(SEG_OPTION_FREEZE, !realtimeOverride, strip.getMainSegmentId());
   }
 
@@ -442,7 +522,7 @@ void serializeSegment(JsonObject& root, WS2812FX::Segment& seg, byte id, bool fo
   root[F("mi")]  = seg.getOption(SEG_OPTION_MIRROR);
 }
 
-void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds)
+void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool segments)
 {
   if (includeBri) {
     root["on"] = (bri > 0);
@@ -477,6 +557,7 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 
   root[F("mainseg")] = strip.getMainSegmentId();
+  if (!segments) return; //streamed one by one by JsonStreamer
 
   JsonArray seg = root.createNestedArray("seg");
   for (byte s = 0; s < strip.getMaxSegments(); s++) {
@@ -511,7 +592,7 @@ int getSignalQuality(int rssi)
     return quality;
 }
 
-void serializeInfo(JsonObject root)
+void serializeInfo(JsonObject root, bool usermodInfo)
 {
   root[F("ver")] = versionString;
   root[F("vid")] = VERSION;
@@ -541,12 +622,48 @@ void serializeInfo(JsonObject root)
   leds[F("wv")]   = totalLC & 0x02;     // deprecated, true if white slider should be displayed for any segment
   leds["cct"]     = totalLC & 0x04;     // deprecated, use info.leds.lc
 
+  leds[F("mem")] = busses.getMemUsage(); // bytes allocated by all busses
+  JsonArray planarr = leds.createNestedArray(F("plan")); // admission result of the last bus configuration
+  for (uint8_t b = 0; b < busses.getNumPlanned(); b++) {
+    const BusPlanEntry* e = busses.getPlanned(b);
+    JsonObject pe = planarr.createNestedObject();
+    pe[F("mem")] = e->mem;
+    switch (e->reject) {
+      case BUS_REJECT_NONE:  pe[F("rej")] = ""; break;
+      case BUS_REJECT_LIMIT: pe[F("rej")] = F("max LED memory"); break;
+      case BUS_REJECT_HEAP:  pe[F("rej")] = F("heap"); break;
+      case BUS_REJECT_PSRAM: pe[F("rej")] = F("PSRAM"); break;
+      case BUS_REJECT_PREV:  pe[F("rej")] = F("previous bus rejected"); break;
+    }
+  }
+
   root[F("str")] = syncToggleReceive;
 
   root[F("name")] = serverDescription;
   root[F("udpport")] = udpPort;
   root["live"] = (bool)realtimeMode;
   root[F("liveseg")] = useMainSegmentOnly ? strip.getMainSegmentId() : -1;  // if using main segment only for live
+
+  JsonObject e131info = root.createNestedObject(F("e131"));
+  e131info[F("frames")] = e131Frames;
+  e131info[F("torn")]   = e131TornFrames;
+  e131info[F("late")]   = e131LateFrames;
+  e131info[F("uni")]    = e131UniverseCount();
+
+  serializeRealtimeStats(root.createNestedObject(F("rt")));
+  #ifndef WLED_USE_DYNAMIC_JSON
+  serializeJSONPool(root.createNestedObject(F("jpool")));
+  #endif
+  serializeRemoteAPI(root.createNestedObject(F("rapi")));
+  serializeStateCoalescing(root.createNestedObject(F("coal")));
+
+  JsonObject rtbuf = root.createNestedObject(F("rtbuf"));
+  rtbuf["n"]            = rtBufFrames;
+  rtbuf[F("lat")]       = rtBufLatency;
+  rtbuf[F("avglat")]    = rtBufLatencyAvg;
+  rtbuf[F("interval")]  = rtBufInterval;
+  rtbuf[F("under")]     = rtBufUnderruns;
+  rtbuf[F("over")]      = rtBufOverruns;
   //root[F("mso")] = useMainSegmentOnly;  // using main segment only for live
 
   switch (realtimeMode) {
@@ -620,7 +737,7 @@ void serializeInfo(JsonObject root)
   #endif
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
 
-  usermods.addToJsonInfo(root);
+  if (usermodInfo) usermods.addToJsonInfo(root);
 
   byte os = 0;
   #ifdef WLED_DEBUG
@@ -661,148 +778,111 @@ void serializeInfo(JsonObject root)
   root["ip"] = s;
 }
 
-void setPaletteColors(JsonArray json, CRGBPalette16 palette)
+/*
+ * Palette previews for /json/palx, written as text straight from the palette tables in flash.
+ * Only used if the palettes differ from the ones compressed into html_palx.h at build time.
+ * They only change with the firmware, so clients revalidate them with a build specific ETag.
+ */
+static size_t printPaletteColors(char* out, const CRGBPalette16& palette)
 {
-    for (int i = 0; i < 16; i++) {
-      JsonArray colors =  json.createNestedArray();
-      CRGB color = palette[i];
-      colors.add(i<<4);
-      colors.add(color.red);
-      colors.add(color.green);
-      colors.add(color.blue);
-    }
+  size_t len = 0;
+  for (uint8_t i = 0; i < 16; i++) {
+    CRGB color = palette[i];
+    len += sprintf_P(out + len, PSTR("%s[%u,%u,%u,%u]"), i ? "," : "", i<<4, color.red, color.green, color.blue);
+  }
+  return len;
 }
 
-void setPaletteColors(JsonArray json, byte* tcp)
+static size_t printPaletteColors(char* out, const byte* tcp)
 {
-    TRGBGradientPaletteEntryUnion* ent = (TRGBGradientPaletteEntryUnion*)(tcp);
-    TRGBGradientPaletteEntryUnion u;
-
-    // Count entries
-    uint16_t count = 0;
-    do {
-        u = *(ent + count);
-        count++;
-    } while ( u.index != 255);
-
-    u = *ent;
-    int indexstart = 0;
-    while( indexstart < 255) {
-      indexstart = u.index;
-
-      JsonArray colors =  json.createNestedArray();
-      colors.add(u.index);
-      colors.add(u.r);
-      colors.add(u.g);
-      colors.add(u.b);
-
-      ent++;
-      u = *ent;
-    }
+  size_t len = 0;
+  const TRGBGradientPaletteEntryUnion* ent = (const TRGBGradientPaletteEntryUnion*)tcp;
+  for (uint8_t i = 0; i < 18; i++, ent++) { //72 bytes at most
+    len += sprintf_P(out + len, PSTR("%s[%u,%u,%u,%u]"), i ? "," : "", ent->index, ent->r, ent->g, ent->b);
+    if (ent->index == 255) break;
+  }
+  return len;
 }
 
-void serializePalettes(JsonObject root, AsyncWebServerRequest* request)
+//"id":[[index,r,g,b],...] or placeholders for the palettes made from the segment colors, out needs 340 bytes
+static size_t printPalettePreview(char* out, uint8_t i)
 {
-  #ifdef ESP8266
-  int itemPerPage = 5;
-  #else
-  int itemPerPage = 8;
-  #endif
+  size_t len = sprintf_P(out, PSTR("\"%u\":["), i);
+  switch (i) {
+    case 0:  len += printPaletteColors(out + len, CRGBPalette16(PartyColors_p)); break; //default palette
+    case 1:  len += sprintf_P(out + len, PSTR("\"r\",\"r\",\"r\",\"r\"")); break; //random
+    case 2:  len += sprintf_P(out + len, PSTR("\"c1\"")); break; //primary color only
+    case 3:  len += sprintf_P(out + len, PSTR("\"c1\",\"c1\",\"c2\",\"c2\"")); break; //primary + secondary
+    case 4:  len += sprintf_P(out + len, PSTR("\"c3\",\"c2\",\"c1\"")); break; //primary + secondary + tertiary
+    case 5:  //primary + secondary (+tert if not off), more distinct
+      len += sprintf_P(out + len, PSTR("\"c1\",\"c1\",\"c1\",\"c1\",\"c1\",\"c2\",\"c2\",\"c2\",\"c2\",\"c2\",\"c3\",\"c3\",\"c3\",\"c3\",\"c3\",\"c1\""));
+      break;
+    case 6:  len += printPaletteColors(out + len, CRGBPalette16(PartyColors_p)); break;
+    case 7:  len += printPaletteColors(out + len, CRGBPalette16(CloudColors_p)); break;
+    case 8:  len += printPaletteColors(out + len, CRGBPalette16(LavaColors_p)); break;
+    case 9:  len += printPaletteColors(out + len, CRGBPalette16(OceanColors_p)); break;
+    case 10: len += printPaletteColors(out + len, CRGBPalette16(ForestColors_p)); break;
+    case 11: len += printPaletteColors(out + len, CRGBPalette16(RainbowColors_p)); break;
+    case 12: len += printPaletteColors(out + len, CRGBPalette16(RainbowStripeColors_p)); break;
+    default: {
+      byte tcp[72];
+      memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[i - 13])), 72);
+      len += printPaletteColors(out + len, tcp);
+      break;
+    }
+  }
+  out[len++] = ']';
+  return len;
+}
 
-  int page = 0;
-  if (request->hasParam("page")) {
-    page = request->getParam("page")->value().toInt();
-  }
-
-  int palettesCount = strip.getPaletteCount();
-
-  int maxPage = (palettesCount -1) / itemPerPage;
-  if (page > maxPage) page = maxPage;
-
-  int start = itemPerPage * page;
-  int end = start + itemPerPage;
-  if (end >= palettesCount) end = palettesCount;
-
-  root[F("m")] = maxPage;
-  JsonObject palettes  = root.createNestedObject("p");
-
-  for (int i = start; i < end; i++) {
-    JsonArray curPalette = palettes.createNestedArray(String(i));
-    switch (i) {
-      case 0: //default palette
-        setPaletteColors(curPalette, PartyColors_p); 
-        break;
-      case 1: //random
-          curPalette.add("r");
-          curPalette.add("r");
-          curPalette.add("r");
-          curPalette.add("r");
-        break;
-      case 2: //primary color only
-        curPalette.add("c1");
-        break;
-      case 3: //primary + secondary
-        curPalette.add("c1");
-        curPalette.add("c1");
-        curPalette.add("c2");
-        curPalette.add("c2");
-        break;
-      case 4: //primary + secondary + tertiary
-        curPalette.add("c3");
-        curPalette.add("c2");
-        curPalette.add("c1");
-        break;
-      case 5: {//primary + secondary (+tert if not off), more distinct
-      
-        curPalette.add("c1");
-        curPalette.add("c1");
-        curPalette.add("c1");
-        curPalette.add("c1");
-        curPalette.add("c1");
-        curPalette.add("c2");
-        curPalette.add("c2");
-        curPalette.add("c2");
-        curPalette.add("c2");
-        curPalette.add("c2");
-        curPalette.add("c3");
-        curPalette.add("c3");
-        curPalette.add("c3");
-        curPalette.add("c3");
-        curPalette.add("c3");
-        curPalette.add("c1");
-        break;}
-      case 6: //Party colors
-        setPaletteColors(curPalette, PartyColors_p);
-        break;
-      case 7: //Cloud colors
-        setPaletteColors(curPalette, CloudColors_p);
-        break;
-      case 8: //Lava colors
-        setPaletteColors(curPalette, LavaColors_p);
-        break;
-      case 9: //Ocean colors
-        setPaletteColors(curPalette, OceanColors_p);
-        break;
-      case 10: //Forest colors
-        setPaletteColors(curPalette, ForestColors_p);
-        break;
-      case 11: //Rainbow colors
-        setPaletteColors(curPalette, RainbowColors_p);
-        break;
-      case 12: //Rainbow stripe colors
-        setPaletteColors(curPalette, RainbowStripeColors_p);
-        break;
-
-      default:
-        if (i < 13) {
-          break;
+//all previews in one response ("m" 0: no further pages), one palette at a time
+class PaletteStreamer {
+  public:
+    size_t fill(uint8_t* buf, size_t maxLen) {
+      size_t n = 0;
+      while (n < maxLen) {
+        if (_pos == _len) {
+          uint8_t count = strip.getPaletteCount();
+          if (_pal > count) break;
+          _pos = 0;
+          if (_pal == count) { _len = sprintf_P(_text, PSTR("}}")); }
+          else {
+            _len = _pal ? sprintf_P(_text, PSTR(",")) : sprintf_P(_text, PSTR("{\"m\":0,\"p\":{"));
+            _len += printPalettePreview(_text + _len, _pal);
+          }
+          _pal++;
         }
-        byte tcp[72];
-        memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[i - 13])), 72);
-        setPaletteColors(curPalette, tcp);
-        break;
+        size_t c = min(maxLen - n, _len - _pos);
+        memcpy(buf + n, _text + _pos, c);
+        n += c; _pos += c;
+      }
+      return n;
     }
-  }
+
+  private:
+    uint16_t _pal = 0;
+    char _text[360]; //a separator and the largest preview
+    size_t _len = 0, _pos = 0;
+};
+
+//effect and palette data only change with the firmware: answered with 304 while the client has the current build
+static bool firmwareDataCached(AsyncWebServerRequest* request, char type, char* tag)
+{
+  sprintf_P(tag, PSTR("%c%lu-%u-%u"), type, (unsigned long)VERSION, strip.getModeCount(), strip.getPaletteCount());
+  AsyncWebHeader* header = request->getHeader("If-None-Match");
+  if (!header || header->value() != tag) return false;
+  request->send(304);
+  return true;
+}
+
+static void sendFirmwareData(AsyncWebServerRequest* request, AsyncWebServerResponse* response, const char* tag)
+{
+  //a client asking for the current build ("?v=") may keep it, otherwise revalidate as the URL stays the same across updates
+  AsyncWebParameter* v = request->getParam("v");
+  bool versioned = v && v->value().toInt() == VERSION;
+  response->addHeader(F("Cache-Control"), versioned ? F("max-age=31536000, immutable") : F("no-cache"));
+  response->addHeader(F("ETag"), tag);
+  request->send(response);
 }
 
 void serializeNodes(JsonObject root)
@@ -823,6 +903,357 @@ void serializeNodes(JsonObject root)
   }
 }
 
+/*
+ * Streams /json, /json/state, /json/info, /json/si and /json/nodes as a chunked response.
+ * Every part (state, each segment, info, usermod info, each node) is serialized on its own into a
+ * small pool document, held for the whole stream, and copied out. Effect and palette names are copied
+ * straight from flash. Memory use is bounded by the largest part, no matter how many segments, nodes or
+ * usermods there are. A part that does not fit fails the stream instead of sending incomplete JSON.
+ */
+enum : uint8_t {
+  JS_OPEN_ALL, JS_STATE, JS_SEG, JS_SEG_CLOSE, JS_INFO_KEY, JS_INFO, JS_INFO_UM,
+  JS_CLOSE, JS_FX, JS_PAL, JS_NODES_OPEN, JS_NODE, JS_NODES_CLOSE, JS_END
+};
+static const uint8_t jsProgAll[]   = {JS_OPEN_ALL, JS_STATE, JS_SEG, JS_SEG_CLOSE, JS_INFO_KEY, JS_INFO, JS_INFO_UM, JS_CLOSE, JS_FX, JS_PAL, JS_CLOSE, JS_END};
+static const uint8_t jsProgSI[]    = {JS_OPEN_ALL, JS_STATE, JS_SEG, JS_SEG_CLOSE, JS_INFO_KEY, JS_INFO, JS_INFO_UM, JS_CLOSE, JS_CLOSE, JS_END};
+static const uint8_t jsProgState[] = {JS_STATE, JS_SEG, JS_SEG_CLOSE, JS_END};
+static const uint8_t jsProgInfo[]  = {JS_INFO, JS_INFO_UM, JS_CLOSE, JS_END};
+static const uint8_t jsProgNodes[] = {JS_NODES_OPEN, JS_NODE, JS_NODES_CLOSE, JS_END};
+
+class JsonStreamer {
+  public:
+    JsonStreamer(byte subJson) {
+      switch (subJson) {
+        case 1:  _prog = jsProgState; break;
+        case 2:  _prog = jsProgInfo;  break;
+        case 3:  _prog = jsProgSI;    break;
+        case 4:  _prog = jsProgNodes; break;
+        default: _prog = jsProgAll;   break;
+      }
+    }
+    ~JsonStreamer() { releaseDoc(); free(_text); }
+
+    //chunked response filler, RESPONSE_TRY_AGAIN while no JSON document is free and once the stream failed
+    size_t fill(uint8_t* buf, size_t maxLen) {
+      if (_failed) return RESPONSE_TRY_AGAIN;
+      size_t n = 0;
+      while (n < maxLen) {
+        if (_pos < _len) {
+          size_t c = min(maxLen - n, _len - _pos);
+          if (_flash) memcpy_P(buf + n, _flash + _pos, c);
+          else        memcpy(buf + n, _text + _pos, c);
+          n += c; _pos += c;
+          continue;
+        }
+        _flash = nullptr;
+        int8_t r = next();
+        if (r == 0) break;
+        if (r < 0) return n ? n : RESPONSE_TRY_AGAIN;
+      }
+      return n;
+    }
+
+    //true once after a part did not fit, the response has to be aborted
+    bool abortNow() {
+      if (!_failed || _aborted) return false;
+      _aborted = true;
+      return true;
+    }
+
+  private:
+    const uint8_t* _prog;
+    uint8_t _step = 0;
+    uint16_t _item = 0;     //segment or node index of a repeating step
+    bool _first = true;     //no comma before the first segment/node
+    char* _text = nullptr;  //staged part
+    size_t _cap = 0, _len = 0, _pos = 0;
+    PGM_P _flash = nullptr; //staged part is in flash (effect/palette names)
+    bool _pendingFlash = false;
+    JsonDocument* _doc = nullptr; //held from the first to the last serialized part
+    bool _failed = false, _aborted = false;
+
+    bool acquireDoc() {
+      if (_doc) return true;
+      #ifdef WLED_USE_DYNAMIC_JSON
+      _doc = new DynamicJsonDocument(JSON_STREAM_DOC_SIZE);
+      if (_doc && !_doc->capacity()) { delete _doc; _doc = nullptr; }
+      if (!_doc) _failed = true;
+      #else
+      _doc = requestJSONBuffer(18, JSON_STREAM_DOC_SIZE, 0, true);
+      #endif
+      return _doc;
+    }
+
+    static bool serialized(uint8_t step) {
+      return step == JS_STATE || step == JS_SEG || step == JS_INFO || step == JS_INFO_UM || step == JS_NODE;
+    }
+
+    //no serialized part left, the effect and palette names are sent without a document
+    void releaseDocIfDone() {
+      if (!_doc) return;
+      for (uint8_t s = _step; _prog[s] != JS_END; s++) if (serialized(_prog[s])) return;
+      releaseDoc();
+    }
+
+    void releaseDoc() {
+      #ifdef WLED_USE_DYNAMIC_JSON
+      delete _doc;
+      #else
+      releaseJSONBuffer(_doc);
+      #endif
+      _doc = nullptr;
+    }
+
+    bool reserve(size_t len) {
+      if (len <= _cap) return true;
+      char* t = (char*)realloc(_text, len);
+      if (!t) { _failed = true; return false; }
+      _text = t; _cap = len;
+      return true;
+    }
+
+    void stage(const char* str) { //literal in flash
+      _len = strlen_P(str); _pos = 0;
+      if (reserve(_len)) memcpy_P(_text, str, _len);
+      else _len = 0;
+    }
+
+    //serializes a part, an open object leaves off its closing brace so more keys can follow
+    void stage(JsonDocument& d, const char* prefix, bool open) {
+      size_t pl = strlen_P(prefix);
+      size_t len = measureJson(d);
+      _pos = 0; _len = 0;
+      if (d.overflowed()) { //part is incomplete
+        DEBUG_PRINTLN(F("JSON stream part too large!"));
+        _failed = true;
+        return;
+      }
+      if (!reserve(pl + len + 1)) return;
+      memcpy_P(_text, prefix, pl);
+      serializeJson(d, _text + pl, len + 1);
+      _len = pl + len - (open ? 1 : 0);
+    }
+
+    //advances to the next part: 1 staged, 0 done, -1 no JSON document free or failed
+    int8_t next() {
+      if (_failed) return -1;
+      uint8_t step = _prog[_step];
+      if (step == JS_END) { releaseDoc(); return 0; }
+      if (!serialized(step)) releaseDocIfDone();
+      if (step == JS_FX || step == JS_PAL) { //key first, then the names by reference
+        if (!_pendingFlash) {
+          stage(step == JS_FX ? PSTR(",\"effects\":") : PSTR(",\"palettes\":"));
+          _pendingFlash = true;
+          return 1;
+        }
+        _flash = (step == JS_FX) ? JSON_mode_names : JSON_palette_names;
+        _len = strlen_P(_flash); _pos = 0;
+        _pendingFlash = false;
+        _step++;
+        return 1;
+      }
+      switch (step) {
+        case JS_OPEN_ALL:    stage(PSTR("{\"state\":")); _step++; return 1;
+        case JS_SEG_CLOSE:   stage(PSTR("]}"));          _step++; return 1;
+        case JS_INFO_KEY:    stage(PSTR(",\"info\":"));  _step++; return 1;
+        case JS_CLOSE:       stage(PSTR("}"));           _step++; return 1;
+        case JS_NODES_OPEN:  stage(PSTR("{\"nodes\":[")); _step++; _first = true; _item = 0; return 1;
+        case JS_NODES_CLOSE: stage(PSTR("]}"));          _step++; return 1;
+      }
+
+      //parts serialized from the device state
+      if (!acquireDoc()) return -1;
+      JsonDocument* d = _doc;
+      switch (step) {
+        case JS_STATE:
+          serializeState(d->to<JsonObject>(), false, true, true, false);
+          stage(*d, PSTR(""), true);
+          if (!_failed && reserve(_len + 8)) { memcpy_P(_text + _len, PSTR(",\"seg\":["), 8); _len += 8; }
+          _step++; _first = true; _item = 0;
+          break;
+        case JS_SEG: //one active segment per call
+          while (_item < strip.getMaxSegments() && !strip.getSegment(_item).isActive()) _item++;
+          if (_item >= strip.getMaxSegments()) { _step++; _len = _pos = 0; break; }
+          {
+            JsonObject seg0 = d->to<JsonObject>();
+            serializeSegment(seg0, strip.getSegment(_item), _item, false, true);
+          }
+          stage(*d, _first ? PSTR("") : PSTR(","), false);
+          _first = false; _item++;
+          break;
+        case JS_INFO:
+          serializeInfo(d->to<JsonObject>(), false);
+          stage(*d, PSTR(""), true);
+          _step++;
+          break;
+        case JS_INFO_UM: //usermod keys continue the info object
+          usermods.addToJsonInfo(d->to<JsonObject>());
+          if (d->size()) {
+            stage(*d, PSTR(""), true);
+            if (_len) _text[0] = ',';
+          } else _len = _pos = 0;
+          _step++;
+          break;
+        case JS_NODE: { //one node per call, found by index as the list may change in between
+          uint16_t i = 0;
+          NodesMap::iterator it = Nodes.begin();
+          for (; it != Nodes.end(); ++it) {
+            if (it->second.ip[0] == 0) continue;
+            if (i++ == _item) break;
+          }
+          if (it == Nodes.end()) { _step++; _len = _pos = 0; break; }
+          JsonObject node = d->to<JsonObject>();
+          node[F("name")] = it->second.nodeName;
+          node["type"]    = it->second.nodeType;
+          node["ip"]      = it->second.ip.toString();
+          node[F("age")]  = it->second.age;
+          node[F("vid")]  = it->second.build;
+          stage(*d, _first ? PSTR("") : PSTR(","), false);
+          _first = false; _item++;
+          break;
+        }
+      }
+      return _failed ? -1 : 1;
+    }
+};
+
+/*
+ * /json/state and /json/info are kept serialized and only rebuilt when their ETag changes.
+ * The state ETag follows stateGeneration (and the nightlight countdown), the info ETag follows
+ * infoGeneration and is refreshed every JSON_INFO_REFRESH_MS for uptime, heap, signal etc.
+ */
+struct JsonBlob {
+  char* data = nullptr;
+  size_t len = 0;
+  ~JsonBlob() { free(data); }
+};
+static std::shared_ptr<JsonBlob> jsonCache[4]; //state, info, then both as MessagePack
+static char jsonCacheTag[4][24];
+static volatile unsigned long jsonCacheUsed = 0; //last poll served from the cache
+static volatile bool jsonCached = false;
+#ifdef ARDUINO_ARCH_ESP32
+//filled by the web server task, expired by the loop. Blobs are only freed outside the lock
+static portMUX_TYPE jsonCacheMux = portMUX_INITIALIZER_UNLOCKED;
+#define JSON_CACHE_LOCK()   portENTER_CRITICAL(&jsonCacheMux)
+#define JSON_CACHE_UNLOCK() portEXIT_CRITICAL(&jsonCacheMux)
+#else
+#define JSON_CACHE_LOCK()
+#define JSON_CACHE_UNLOCK()
+#endif
+
+static void jsonETag(byte subJson, bool msgpack, char* tag) {
+  if (subJson == 1) sprintf_P(tag, PSTR("%ss%u-%lu"), msgpack ? "m" : "", stateGeneration, nightlightActive ? millis()/1000 : 0UL);
+  else              sprintf_P(tag, PSTR("%si%u-%lu"), msgpack ? "m" : "", infoGeneration, millis()/JSON_INFO_REFRESH_MS);
+}
+
+//true if the client prefers MessagePack, only state and info are offered in it
+bool acceptsMsgPack(AsyncWebServerRequest* request) {
+  AsyncWebHeader* header = request->getHeader("Accept");
+  return header && isMsgPackMediaType(header->value().c_str());
+}
+
+//state (1), info (2) or both (3) as MessagePack, nullptr if no JSON document was free
+static std::shared_ptr<JsonBlob> buildMsgPackBlob(byte subJson) {
+  #ifdef WLED_USE_DYNAMIC_JSON
+  DynamicJsonDocument doc(JSON_BUFFER_SIZE);
+  #else
+  JsonDocument* pDoc = requestJSONBuffer(19);
+  if (!pDoc) return nullptr;
+  JsonDocument& doc = *pDoc;
+  #endif
+  if (subJson != 2) {
+    JsonObject state = subJson == 1 ? doc.to<JsonObject>() : doc.createNestedObject("state");
+    serializeState(state);
+    if (!expandSegmentColors(state)) { releaseJSONBuffer(&doc); return nullptr; }
+  }
+  if (subJson != 1) serializeInfo(subJson == 2 ? doc.to<JsonObject>() : doc.createNestedObject("info"));
+  std::shared_ptr<JsonBlob> blob(new JsonBlob());
+  size_t len = measureMsgPack(doc);
+  blob->data = (char*)malloc(len);
+  if (blob->data) blob->len = serializeMsgPack(doc, blob->data, len);
+  releaseJSONBuffer(&doc);
+  return blob->data ? blob : nullptr;
+}
+
+static void sendJsonBlob(AsyncWebServerRequest* request, std::shared_ptr<JsonBlob> blob, bool msgpack, const char* tag) {
+  AsyncWebServerResponse* response = request->beginResponse(jsonContentType(msgpack), blob->len,
+    [blob](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+      size_t c = min(maxLen, blob->len - index);
+      memcpy(buf, blob->data + index, c);
+      return c;
+    });
+  response->addHeader(F("Vary"), F("Accept"));
+  if (tag) {
+    response->addHeader(F("Cache-Control"), "no-cache");
+    response->addHeader(F("ETag"), tag);
+  }
+  request->send(response);
+}
+
+//collects a streamed response, nullptr if no JSON document was free
+static std::shared_ptr<JsonBlob> buildJsonBlob(byte subJson, bool msgpack) {
+  if (msgpack) return buildMsgPackBlob(subJson);
+  JsonStreamer js(subJson);
+  std::shared_ptr<JsonBlob> blob(new JsonBlob());
+  size_t cap = 0, n;
+  do { //doubled when full, so a large info needs a few reallocations instead of one per chunk
+    if (blob->len == cap) {
+      cap = cap ? 2 * cap : 1024;
+      char* d = (char*)realloc(blob->data, cap);
+      if (!d) return nullptr;
+      blob->data = d;
+    }
+    n = js.fill((uint8_t*)blob->data + blob->len, cap - blob->len);
+    if (n == RESPONSE_TRY_AGAIN) return nullptr;
+    blob->len += n;
+  } while (n);
+  char* d = (char*)realloc(blob->data, blob->len); //the cache keeps it
+  if (d || !blob->len) blob->data = d;
+  return blob;
+}
+
+//answers unchanged polls with 304 and everything else from the cache, false to stream instead
+static bool serveCachedJson(AsyncWebServerRequest* request, byte subJson, bool msgpack) {
+  if (errorFlag) return false; //errors are reported once, never cached
+  char tag[24];
+  jsonETag(subJson, msgpack, tag);
+  AsyncWebHeader* header = request->getHeader("If-None-Match");
+  if (header && header->value() == tag) {
+    request->send(304);
+    return true;
+  }
+
+  byte c = subJson - 1 + (msgpack ? 2 : 0);
+  JSON_CACHE_LOCK();
+  std::shared_ptr<JsonBlob> blob = jsonCache[c];
+  bool stale = !blob || strcmp(jsonCacheTag[c], tag);
+  jsonCacheUsed = millis();
+  JSON_CACHE_UNLOCK();
+  if (stale) {
+    blob = buildJsonBlob(subJson, msgpack);
+    if (!blob) return false;
+    std::shared_ptr<JsonBlob> old = blob;
+    JSON_CACHE_LOCK();
+    jsonCache[c].swap(old);
+    strcpy(jsonCacheTag[c], tag);
+    jsonCached = true;
+    JSON_CACHE_UNLOCK();
+  }
+  sendJsonBlob(request, blob, msgpack, tag);
+  return true;
+}
+
+//called by the loop: frees the cached state and info once nobody polls them any more
+void expireJsonCache()
+{
+  if (!jsonCached || millis() - jsonCacheUsed < JSON_CACHE_IDLE_MS) return;
+  std::shared_ptr<JsonBlob> old[4];
+  JSON_CACHE_LOCK();
+  for (byte c = 0; c < 4; c++) jsonCache[c].swap(old[c]);
+  jsonCached = false;
+  JSON_CACHE_UNLOCK();
+} //freed here, responses still sending keep their own reference
+
 void serveJson(AsyncWebServerRequest* request)
 {
   byte subJson = 0;
@@ -838,12 +1269,17 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
   #endif
-  else if (url.indexOf(F("eff")) > 0) {
-    request->send_P(200, "application/json", JSON_mode_names);
+  #ifdef WLED_ENABLE_RECORDER
+  else if (url.indexOf("rec")   > 0) {
+    serveRecording(request);
     return;
   }
-  else if (url.indexOf("pal") > 0) {
-    request->send_P(200, "application/json", JSON_palette_names);
+  #endif
+  else if (url.indexOf(F("eff")) > 0 || url.indexOf("pal") > 0) {
+    char tag[24];
+    bool fx = url.indexOf(F("eff")) > 0;
+    if (firmwareDataCached(request, fx ? 'e' : 'n', tag)) return;
+    sendFirmwareData(request, request->beginResponse_P(200, "application/json", fx ? JSON_mode_names : JSON_palette_names), tag);
     return;
   }
   else if (url.indexOf("cfg") > 0 && handleFileRead(request, "/cfg.json")) {
@@ -854,43 +1290,48 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  #ifdef WLED_USE_DYNAMIC_JSON
-  AsyncJsonResponse* response = new AsyncJsonResponse(JSON_BUFFER_SIZE);
-  #else
-  if (!requestJSONBufferLock(17)) return;
-  AsyncJsonResponse *response = new AsyncJsonResponse(&doc);
-  #endif
-
-  JsonObject lDoc = response->getRoot();
-
-  switch (subJson)
-  {
-    case 1: //state
-      serializeState(lDoc); break;
-    case 2: //info
-      serializeInfo(lDoc); break;
-    case 4: //node list
-      serializeNodes(lDoc); break;
-    case 5: //palettes
-      serializePalettes(lDoc, request); break;
-    default: //all
-      JsonObject state = lDoc.createNestedObject("state");
-      serializeState(state);
-      JsonObject info = lDoc.createNestedObject("info");
-      serializeInfo(info);
-      if (subJson != 3)
-      {
-        doc[F("effects")]  = serialized((const __FlashStringHelper*)JSON_mode_names);
-        doc[F("palettes")] = serialized((const __FlashStringHelper*)JSON_palette_names);
-      }
+  //MessagePack is offered for state and info, everything else is answered as JSON
+  bool msgpack = subJson >= 1 && subJson <= 3 && acceptsMsgPack(request);
+  if ((subJson == 1 || subJson == 2) && serveCachedJson(request, subJson, msgpack)) return;
+  if (msgpack) {
+    std::shared_ptr<JsonBlob> blob = buildMsgPackBlob(subJson);
+    if (!blob) request->send(503, "application/json", F("{\"error\":3}"));
+    else sendJsonBlob(request, blob, true, nullptr);
+    return;
   }
 
-  DEBUG_PRINT("JSON buffer size: ");
-  DEBUG_PRINTLN(lDoc.memoryUsage());
+  if (subJson == 5) { //palette previews
+    char tag[24];
+    if (firmwareDataCached(request, 'p', tag)) return;
+    if (strip.getPaletteCount() == JSON_PALX_COUNT) { //compressed at build time by tools/palettes.js
+      AsyncWebServerResponse* response = request->beginResponse_P(200, "application/json", JSON_palx, JSON_palx_L);
+      response->addHeader(F("Content-Encoding"), "gzip");
+      sendFirmwareData(request, response, tag);
+      return;
+    }
+    std::shared_ptr<PaletteStreamer> ps(new PaletteStreamer());
+    sendFirmwareData(request, request->beginChunkedResponse("application/json",
+      [ps](uint8_t* buf, size_t maxLen, size_t index) -> size_t { return ps->fill(buf, maxLen); }), tag);
+    return;
+  }
 
-  response->setLength();
+  std::shared_ptr<JsonStreamer> js(new JsonStreamer(subJson));
+  AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+    [js, request](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+      size_t n = js->fill(buf, maxLen);
+      //drop the connection without the final chunk so the client sees an error, not truncated JSON.
+      //the request must not be deleted from within its own response: AsyncTCP (ESP32) handles the abort
+      //in its task afterwards, ESPAsyncTCP (ESP8266) closes on the next poll. Nothing else is sent meanwhile
+      if (js->abortNow()) {
+        #ifdef ARDUINO_ARCH_ESP32
+        request->client()->abort();
+        #else
+        request->client()->close();
+        #endif
+      }
+      return n;
+    });
   request->send(response);
-  releaseJSONBufferLock();
 }
 
 #ifdef WLED_ENABLE_JSONLIVE
@@ -935,4 +1376,42 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
   #endif
   return true;
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef WLED_ENABLE_RECORDER
+static BusRecorder* getRecorder() {
+  for (uint8_t b = 0; b < busses.getNumBusses(); b++) {
+    Bus* bus = busses.getBus(b);
+    if (bus && IS_REC(bus->getType()) && bus->isOk()) return static_cast<BusRecorder*>(bus);
+  }
+  return nullptr;
+}
+
+//download the recording of the first frame recorder bus
+void serveRecording(AsyncWebServerRequest* request)
+{
+  BusRecorder* rec = getRecorder();
+  if (!rec) {
+    request->send(404, "application/json", F("{\"error\":\"No recorder\"}"));
+    return;
+  }
+  //recording stays paused for the whole response, the request is deleted on disconnect also after completion
+  rec->hold();
+  request->onDisconnect([]() {
+    BusRecorder* rec = getRecorder(); //bus may have been recreated meanwhile, release() ignores unheld recorders
+    if (rec) rec->release();
+  });
+  if (rec->getType() == TYPE_REC_FILE) {
+    request->send(WLED_FS, REC_FILE_NAME, "application/octet-stream", true);
+    return;
+  }
+  AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", rec->getRecordingSize(),
+    [](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      BusRecorder* rec = getRecorder(); //bus may have been removed meanwhile
+      if (!rec) return 0;
+      return rec->readRecording(buffer, maxLen, index);
+    });
+  response->addHeader(F("Content-Disposition"), F("attachment; filename=\"rec.bin\""));
+  request->send(response);
+}
+#endif
@@ -92,21 +92,56 @@ void applyFinalBri() {
 }
 
 
+/*
+ * State changes are coalesced: stateUpdated() only records that something changed, all changes
+ * until the next frame are applied at once by handleStateUpdates() with one UDP notification,
+ * one transition start and one interface update.
+ */
+static uint32_t stateUpdateRequests = 0, stateUpdateCommits = 0;
+static unsigned long lastStateCommit = 0;
+static bool stateUpdateChanged = false; //stateChanged was set by one of the pending updates
+
+static bool callModeNotifies(byte callMode) {
+  return callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY;
+}
+
 //called after every state changes, schedules interface updates, handles brightness transition and nightlight activation
 //unlike colorUpdated(), does NOT apply any colors or FX to segments
 void stateUpdated(byte callMode) {
   //call for notifier -> 0: init 1: direct change 2: button 3: notification 4: nightlight 5: other (No notification)
   //                     6: fx changed 7: hue 8: preset cycle 9: blynk 10: alexa 11: ws send only 12: button preset
   setValuesFromFirstSelectedSeg();
+  stateGeneration++;
+  infoGeneration++; //segment light capabilities
+  stateUpdateRequests++;
+
+  //done right away, so a preset applied after this call stays the current one
+  if (stateChanged) {
+    currentPreset = 0; //something changed, so we are no longer in the preset
+    stateUpdateChanged = true;
+    stateChanged = false;
+  }
 
-  if (bri != briOld || stateChanged) {
-    if (stateChanged) currentPreset = 0; //something changed, so we are no longer in the preset
-        
+  //a change that should be sent to other instances wins over received or silent ones
+  if (!stateUpdatePending || callModeNotifies(callMode) || !callModeNotifies(stateUpdateMode)) stateUpdateMode = callMode;
+  stateUpdatePending = true;
+}
+
+//applies the pending state changes once per frame
+void handleStateUpdates(bool force) {
+  if (!stateUpdatePending) return;
+  if (!force && millis() - lastStateCommit < 1000U / strip.getTargetFps()) return;
+  byte callMode = stateUpdateMode;
+  stateUpdatePending = false;
+  lastStateCommit = millis();
+  stateUpdateCommits++;
+
+  if (bri != briOld || stateUpdateChanged) {
     if (callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY) notify(callMode);
     
     //set flag to update blynk, ws and mqtt
     interfaceUpdateCallMode = callMode;
-    stateChanged = false;
+    stateUpdateChanged = false;
   } else {
     if (nightlightActive && !nightlightActiveOld && callMode != CALL_MODE_NOTIFICATION && callMode != CALL_MODE_NO_NOTIFY) {
       notify(CALL_MODE_NIGHTLIGHT); 
@@ -153,6 +188,13 @@ void stateUpdated(byte callMode) {
   }
 }
 
+void serializeStateCoalescing(JsonObject root)
+{
+  root[F("req")] = stateUpdateRequests;
+  root[F("apl")] = stateUpdateCommits;
+  root[F("ratio")] = stateUpdateCommits ? (stateUpdateRequests * 100 / stateUpdateCommits) / 100.0f : 0; //requests per applied update
+}
+
 
 void updateInterfaces(uint8_t callMode)
 {
@@ -91,18 +91,9 @@ void onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties
     colorUpdated(CALL_MODE_DIRECT_CHANGE);
   } else if (strcmp_P(topic, PSTR("/api")) == 0) {
     if (payload[0] == '{') { //JSON API
-      #ifdef WLED_USE_DYNAMIC_JSON
-      DynamicJsonDocument doc(JSON_BUFFER_SIZE);
-      #else
-      if (!requestJSONBufferLock(15)) return;
-      #endif
-      deserializeJson(doc, payloadStr);
-      deserializeState(doc.as<JsonObject>());
-      releaseJSONBufferLock();
+      applyRemoteJSON(payloadStr, len, true);
     } else { //HTTP API
-      String apireq = "win&";
-      apireq += (char*)payloadStr;
-      handleSet(nullptr, apireq);
+      applyRemoteSet(payloadStr, len);
     }
   } else if (strlen(topic) != 0) {
     // non standard topic, check with usermods
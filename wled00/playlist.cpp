@@ -49,6 +49,7 @@ void unloadPlaylist() {
   }
   currentPlaylist = playlistIndex = -1;
   playlistLen = playlistEntryDur = playlistOptions = 0;
+  stateGeneration++;
   DEBUG_PRINTLN(F("Playlist unloaded."));
 }
 
@@ -112,6 +113,7 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
   if (shuffle) playlistOptions += PL_OPTION_SHUFFLE;
 
   currentPlaylist = presetId;
+  stateGeneration++;
   DEBUG_PRINTLN(F("Playlist loaded."));
   return currentPlaylist;
 }
@@ -119,8 +121,8 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
 
 void handlePlaylist() {
   static unsigned long presetCycledTime = 0;
-  // if fileDoc is not null JSON buffer is in use so just quit
-  if (currentPlaylist < 0 || playlistEntries == nullptr || fileDoc != nullptr) return;
+  // if no JSON document is free the preset could not be loaded, try again next loop
+  if (currentPlaylist < 0 || playlistEntries == nullptr || !jsonBufferAvailable()) return;
 
   if (millis() - presetCycledTime > (100*playlistEntryDur)) {
     presetCycledTime = millis();
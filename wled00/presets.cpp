@@ -10,28 +10,25 @@ bool applyPreset(byte index, byte callMode)
 
   const char *filename = index < 255 ? "/presets.json" : "/tmp.json";
 
-	uint8_t core = 1;
-	//crude way to determine if this was called by a network request
-	#ifdef ARDUINO_ARCH_ESP32
-	core = xPortGetCoreID();
-	#endif
-
-	//only allow use of fileDoc from the core responsible for network requests
-	//do not use active network request doc from preset called by main loop (playlist, schedule, ...)
-  if (fileDoc && core) {
+  //reuse the document of the state (JSON API request, IR command...) that loads this preset, lent by deserializeState()
+  //presets called by the main loop (playlist, schedule, ...) take their own pool document
+  JsonDocument* fileDoc = ownJSONBuffer();
+  if (fileDoc) {
     errorFlag = readObjectFromFileUsingId(filename, index, fileDoc) ? ERR_NONE : ERR_FS_PLOAD;
     JsonObject fdo = fileDoc->as<JsonObject>();
     if (fdo["ps"] == index) fdo.remove("ps"); //remove load request for same presets to prevent recursive crash
     #ifdef WLED_DEBUG_FS
       serializeJson(*fileDoc, Serial);
     #endif
-    deserializeState(fdo, callMode, index);
+    deserializeState(fdo, callMode, index, fileDoc);
   } else {
     DEBUGFS_PRINTLN(F("Make read buf"));
     #ifdef WLED_USE_DYNAMIC_JSON
     DynamicJsonDocument doc(JSON_BUFFER_SIZE);
     #else
-    if (!requestJSONBufferLock(9)) return false;
+    JsonDocument* pDoc = requestJSONBuffer(9);
+    if (!pDoc) { errorFlag = ERR_NOBUF; return false; }
+    JsonDocument& doc = *pDoc;
     #endif
     errorFlag = readObjectFromFileUsingId(filename, index, &doc) ? ERR_NONE : ERR_FS_PLOAD;
     JsonObject fdo = doc.as<JsonObject>();
@@ -39,8 +36,8 @@ bool applyPreset(byte index, byte callMode)
     #ifdef WLED_DEBUG_FS
       serializeJson(doc, Serial);
     #endif
-    deserializeState(fdo, callMode, index);
-    releaseJSONBufferLock();
+    deserializeState(fdo, callMode, index, &doc);
+    releaseJSONBuffer(&doc);
   }
 
   if (!errorFlag) {
@@ -59,12 +56,15 @@ void savePreset(byte index, const char* pname, JsonObject saveobj)
   bool persist = (index != 255);
   const char *filename = persist ? "/presets.json" : "/tmp.json";
 
+  JsonDocument* fileDoc = ownJSONBuffer();
   if (!fileDoc) {
     DEBUGFS_PRINTLN(F("Allocating saving buffer"));
     #ifdef WLED_USE_DYNAMIC_JSON
     DynamicJsonDocument doc(JSON_BUFFER_SIZE);
     #else
-    if (!requestJSONBufferLock(10)) return;
+    JsonDocument* pDoc = requestJSONBuffer(10);
+    if (!pDoc) { errorFlag = ERR_NOBUF; return; }
+    JsonDocument& doc = *pDoc;
     #endif
     sObj = doc.to<JsonObject>();
 
@@ -79,7 +79,7 @@ void savePreset(byte index, const char* pname, JsonObject saveobj)
 
     writeObjectToFileUsingId(filename, index, &doc);
 
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
   } else { //from JSON API (fileDoc != nullptr)
     DEBUGFS_PRINTLN(F("Reuse recv buffer"));
     sObj.remove(F("psave"));
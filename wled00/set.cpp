@@ -447,7 +447,9 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     #ifdef WLED_USE_DYNAMIC_JSON
     DynamicJsonDocument doc(JSON_BUFFER_SIZE);
     #else
-    if (!requestJSONBufferLock(5)) return;
+    JsonDocument* pDoc = requestJSONBuffer(5);
+    if (!pDoc) return;
+    JsonDocument& doc = *pDoc;
     #endif
 
     JsonObject um = doc.createNestedObject("um");
@@ -526,7 +528,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     }
     usermods.readFromConfig(um);  // force change of usermod parameters
 
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
   }
   
   if (subPage != 2 && (subPage != 6 || !doReboot)) serializeConfig(); //do not save if factory reset or LED settings (which are saved after LED re-init)
@@ -535,13 +537,6 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
 
 
 
-//helper to get int value at a position in string
-int getNumVal(const String* req, uint16_t pos)
-{
-  return req->substring(pos+3).toInt();
-}
-
-
 //helper to get int value with in/decrementing support via ~ syntax
 void parseNumber(const char* str, byte* val, byte minv, byte maxv)
 {
@@ -550,26 +545,7 @@ void parseNumber(const char* str, byte* val, byte minv, byte maxv)
   bool wrap = false;
   if (str[0] == 'w' && strlen(str) > 1) {str++; wrap = true;}
   if (str[0] == '~') {
-    int out = atoi(str +1);
-    if (out == 0)
-    {
-      if (str[1] == '0') return;
-      if (str[1] == '-')
-      {
-        *val = (int)(*val -1) < (int)minv ? maxv : min((int)maxv,(*val -1)); //-1, wrap around
-      } else {
-        *val = (int)(*val +1) > (int)maxv ? minv : max((int)minv,(*val +1)); //+1, wrap around
-      }
-    } else {
-      if (wrap && *val == maxv && out > 0) out = minv;
-      else if (wrap && *val == minv && out < 0) out = maxv;
-      else { 
-        out += *val;
-        if (out > maxv) out = maxv;
-        if (out < minv) out = minv;
-      }
-      *val = out;
-    }
+    *val = stepValue(str +1, *val, minv, maxv, wrap);
   } else
   {
     byte p1 = atoi(str);
@@ -586,12 +562,11 @@ void parseNumber(const char* str, byte* val, byte minv, byte maxv)
 }
 
 
-bool updateVal(const String* req, const char* key, byte* val, byte minv, byte maxv)
+//parses the value of a key, false if the key was not in the request
+bool updateVal(const char* str, byte* val, byte minv, byte maxv)
 {
-  int pos = req->indexOf(key);
-  if (pos < 1) return false;
-  if (req->length() < (unsigned int)(pos + 4)) return false;
-  parseNumber(req->c_str() + pos +3, val, minv, maxv);
+  if (str == nullptr || str[0] == '\0') return false;
+  parseNumber(str, val, minv, maxv);
   return true;
 }
 
@@ -599,25 +574,25 @@ bool updateVal(const String* req, const char* key, byte* val, byte minv, byte ma
 //HTTP API request parser
 bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
 {
-  if (!(req.indexOf("win") >= 0)) return false;
+  if (strstr(req.c_str(), "win") == nullptr) return false;
 
-  int pos = 0;
   DEBUG_PRINT(F("API req: "));
   DEBUG_PRINTLN(req);
 
+  const char* v[SK_COUNT];
+  tokenizeSet(req.c_str(), v);
+
   //segment select (sets main segment)
-  pos = req.indexOf(F("SM="));
-  if (pos > 0) {
-    strip.setMainSegmentId(getNumVal(&req, pos));
+  if (v[SK_SM]) {
+    strip.setMainSegmentId(atoi(v[SK_SM]));
   }
 
   byte selectedSeg = strip.getFirstSelectedSegId();
 
   bool singleSegment = false;
 
-  pos = req.indexOf(F("SS="));
-  if (pos > 0) {
-    byte t = getNumVal(&req, pos);
+  if (v[SK_SS]) {
+    byte t = atoi(v[SK_SS]);
     if (t < strip.getMaxSegments()) {
       selectedSeg = t;
       singleSegment = true;
@@ -625,9 +600,8 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   WS2812FX::Segment& selseg = strip.getSegment(selectedSeg);
-  pos = req.indexOf(F("SV=")); //segment selected
-  if (pos > 0) {
-    byte t = getNumVal(&req, pos);
+  if (v[SK_SV]) { //segment selected
+    byte t = atoi(v[SK_SV]);
     if (t == 2) for (uint8_t i = 0; i < strip.getMaxSegments(); i++) strip.getSegment(i).setOption(SEG_OPTION_SELECTED, 0); // unselect other segments
     selseg.setOption(SEG_OPTION_SELECTED, t);
   }
@@ -646,93 +620,80 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   uint16_t stopI  = selseg.stop;
   uint8_t  grpI   = selseg.grouping;
   uint16_t spcI   = selseg.spacing;
-  pos = req.indexOf(F("&S=")); //segment start
-  if (pos > 0) {
-    startI = getNumVal(&req, pos);
+  if (v[SK_S]) { //segment start
+    startI = atoi(v[SK_S]);
   }
-  pos = req.indexOf(F("S2=")); //segment stop
-  if (pos > 0) {
-    stopI = getNumVal(&req, pos);
+  if (v[SK_S2]) { //segment stop
+    stopI = atoi(v[SK_S2]);
   }
-  pos = req.indexOf(F("GP=")); //segment grouping
-  if (pos > 0) {
-    grpI = getNumVal(&req, pos);
+  if (v[SK_GP]) { //segment grouping
+    grpI = atoi(v[SK_GP]);
     if (grpI == 0) grpI = 1;
   }
-  pos = req.indexOf(F("SP=")); //segment spacing
-  if (pos > 0) {
-    spcI = getNumVal(&req, pos);
+  if (v[SK_SP]) { //segment spacing
+    spcI = atoi(v[SK_SP]);
   }
   strip.setSegment(selectedSeg, startI, stopI, grpI, spcI);
 
-  pos = req.indexOf(F("RV=")); //Segment reverse
-  if (pos > 0) selseg.setOption(SEG_OPTION_REVERSED, req.charAt(pos+3) != '0');
+  if (v[SK_RV]) selseg.setOption(SEG_OPTION_REVERSED, v[SK_RV][0] != '0'); //Segment reverse
 
-  pos = req.indexOf(F("MI=")); //Segment mirror
-  if (pos > 0) selseg.setOption(SEG_OPTION_MIRROR, req.charAt(pos+3) != '0');
+  if (v[SK_MI]) selseg.setOption(SEG_OPTION_MIRROR, v[SK_MI][0] != '0'); //Segment mirror
 
-  pos = req.indexOf(F("SB=")); //Segment brightness/opacity
-  if (pos > 0) {
-    byte segbri = getNumVal(&req, pos);
+  if (v[SK_SB]) { //Segment brightness/opacity
+    byte segbri = atoi(v[SK_SB]);
     selseg.setOption(SEG_OPTION_ON, segbri, selectedSeg);
     if (segbri) {
       selseg.setOpacity(segbri, selectedSeg);
     }
   }
 
-  pos = req.indexOf(F("SW=")); //segment power
-  if (pos > 0) {
-    switch (getNumVal(&req, pos)) {
+  if (v[SK_SW]) { //segment power
+    switch (atoi(v[SK_SW])) {
       case 0: selseg.setOption(SEG_OPTION_ON, false); break;
       case 1: selseg.setOption(SEG_OPTION_ON, true); break;
       default: selseg.setOption(SEG_OPTION_ON, !selseg.getOption(SEG_OPTION_ON)); break;
     }
   }
 
-  pos = req.indexOf(F("PS=")); //saves current in preset
-  if (pos > 0) savePreset(getNumVal(&req, pos));
+  if (v[SK_PS]) savePreset(atoi(v[SK_PS])); //saves current in preset
 
-  pos = req.indexOf(F("P1=")); //sets first preset for cycle
-  if (pos > 0) presetCycMin = getNumVal(&req, pos);
+  if (v[SK_P1]) presetCycMin = atoi(v[SK_P1]); //sets first preset for cycle
 
-  pos = req.indexOf(F("P2=")); //sets last preset for cycle
-  if (pos > 0) presetCycMax = getNumVal(&req, pos);
+  if (v[SK_P2]) presetCycMax = atoi(v[SK_P2]); //sets last preset for cycle
 
   //apply preset
-  if (updateVal(&req, "PL=", &presetCycCurr, presetCycMin, presetCycMax)) {
+  if (updateVal(v[SK_PL], &presetCycCurr, presetCycMin, presetCycMax)) {
 		unloadPlaylist();
     applyPreset(presetCycCurr);
   }
 
   //set brightness
-  updateVal(&req, "&A=", &bri);
+  updateVal(v[SK_A], &bri);
 
   bool col0Changed = false, col1Changed = false;
   //set colors
-  col0Changed |= updateVal(&req, "&R=", &colIn[0]);
-  col0Changed |= updateVal(&req, "&G=", &colIn[1]);
-  col0Changed |= updateVal(&req, "&B=", &colIn[2]);
-  col0Changed |= updateVal(&req, "&W=", &colIn[3]);
+  col0Changed |= updateVal(v[SK_R], &colIn[0]);
+  col0Changed |= updateVal(v[SK_G], &colIn[1]);
+  col0Changed |= updateVal(v[SK_B], &colIn[2]);
+  col0Changed |= updateVal(v[SK_W], &colIn[3]);
 
-  col1Changed |= updateVal(&req, "R2=", &colInSec[0]);
-  col1Changed |= updateVal(&req, "G2=", &colInSec[1]);
-  col1Changed |= updateVal(&req, "B2=", &colInSec[2]);
-  col1Changed |= updateVal(&req, "W2=", &colInSec[3]);
+  col1Changed |= updateVal(v[SK_R2], &colInSec[0]);
+  col1Changed |= updateVal(v[SK_G2], &colInSec[1]);
+  col1Changed |= updateVal(v[SK_B2], &colInSec[2]);
+  col1Changed |= updateVal(v[SK_W2], &colInSec[3]);
 
   #ifdef WLED_ENABLE_LOXONE
   //lox parser
-  pos = req.indexOf(F("LX=")); // Lox primary color
-  if (pos > 0) {
-    int lxValue = getNumVal(&req, pos);
+  if (v[SK_LX]) { // Lox primary color
+    int lxValue = atoi(v[SK_LX]);
     if (parseLx(lxValue, colIn)) {
       bri = 255;
       nightlightActive = false; //always disable nightlight when toggling
       col0Changed = true;
     }
   }
-  pos = req.indexOf(F("LY=")); // Lox secondary color
-  if (pos > 0) {
-    int lxValue = getNumVal(&req, pos);
+  if (v[SK_LY]) { // Lox secondary color
+    int lxValue = atoi(v[SK_LY]);
     if(parseLx(lxValue, colInSec)) {
       bri = 255;
       nightlightActive = false; //always disable nightlight when toggling
@@ -742,42 +703,36 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   #endif
 
   //set hue
-  pos = req.indexOf(F("HU="));
-  if (pos > 0) {
-    uint16_t temphue = getNumVal(&req, pos);
+  if (v[SK_HU]) {
+    uint16_t temphue = atoi(v[SK_HU]);
     byte tempsat = 255;
-    pos = req.indexOf(F("SA="));
-    if (pos > 0) {
-      tempsat = getNumVal(&req, pos);
+    if (v[SK_SA]) {
+      tempsat = atoi(v[SK_SA]);
     }
-    byte sec = req.indexOf(F("H2"));
-    colorHStoRGB(temphue, tempsat, (sec>0) ? colInSec : colIn);
+    bool sec = v[SK_H2];
+    colorHStoRGB(temphue, tempsat, sec ? colInSec : colIn);
     col0Changed |= (!sec); col1Changed |= sec;
   }
 
   //set white spectrum (kelvin)
-  pos = req.indexOf(F("&K="));
-  if (pos > 0) {
-    byte sec = req.indexOf(F("K2"));
-    colorKtoRGB(getNumVal(&req, pos), (sec>0) ? colInSec : colIn);
+  if (v[SK_K]) {
+    bool sec = v[SK_K2];
+    colorKtoRGB(atoi(v[SK_K]), sec ? colInSec : colIn);
     col0Changed |= (!sec); col1Changed |= sec;
   }
 
   //set color from HEX or 32bit DEC
   byte tmpCol[4];
-  pos = req.indexOf(F("CL="));
-  if (pos > 0) {
-    colorFromDecOrHexString(colIn, (char*)req.substring(pos + 3).c_str());
+  if (v[SK_CL]) {
+    colorFromDecOrHexString(colIn, (char*)v[SK_CL]);
     col0Changed = true;
   }
-  pos = req.indexOf(F("C2="));
-  if (pos > 0) {
-    colorFromDecOrHexString(colInSec, (char*)req.substring(pos + 3).c_str());
+  if (v[SK_C2]) {
+    colorFromDecOrHexString(colInSec, (char*)v[SK_C2]);
     col1Changed = true;
   }
-  pos = req.indexOf(F("C3="));
-  if (pos > 0) {
-    colorFromDecOrHexString(tmpCol, (char*)req.substring(pos + 3).c_str());
+  if (v[SK_C3]) {
+    colorFromDecOrHexString(tmpCol, (char*)v[SK_C3]);
     uint32_t col2 = RGBW32(tmpCol[0], tmpCol[1], tmpCol[2], tmpCol[3]);
     selseg.setColor(2, col2, selectedSeg); // defined above (SS= or main)
     stateChanged = true;
@@ -785,16 +740,14 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //set to random hue SR=0->1st SR=1->2nd
-  pos = req.indexOf(F("SR"));
-  if (pos > 0) {
-    byte sec = getNumVal(&req, pos);
+  if (v[SK_SR]) {
+    byte sec = atoi(v[SK_SR]);
     setRandomColor(sec? colInSec : colIn);
     col0Changed |= (!sec); col1Changed |= sec;
   }
 
   //swap 2nd & 1st
-  pos = req.indexOf(F("SC"));
-  if (pos > 0) {
+  if (v[SK_SC]) {
     byte temp;
     for (uint8_t i=0; i<4; i++) {
       temp        = colIn[i];
@@ -821,13 +774,13 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
 
   bool fxModeChanged = false, speedChanged = false, intensityChanged = false, paletteChanged = false;
   // set effect parameters
-  if (updateVal(&req, "FX=", &effectIn, 0, strip.getModeCount()-1)) {
+  if (updateVal(v[SK_FX], &effectIn, 0, strip.getModeCount()-1)) {
     if (request != nullptr) unloadPlaylist(); // unload playlist if changing FX using web request
     fxModeChanged = true;
   }
-  speedChanged     = updateVal(&req, "SX=", &speedIn);
-  intensityChanged = updateVal(&req, "IX=", &intensityIn);
-  paletteChanged   = updateVal(&req, "FP=", &paletteIn, 0, strip.getPaletteCount()-1);
+  speedChanged     = updateVal(v[SK_SX], &speedIn);
+  intensityChanged = updateVal(v[SK_IX], &intensityIn);
+  paletteChanged   = updateVal(v[SK_FP], &paletteIn, 0, strip.getPaletteCount()-1);
   
   stateChanged |= (fxModeChanged || speedChanged || intensityChanged || paletteChanged);
 
@@ -842,34 +795,28 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //set advanced overlay
-  pos = req.indexOf(F("OL="));
-  if (pos > 0) {
-    overlayCurrent = getNumVal(&req, pos);
+  if (v[SK_OL]) {
+    overlayCurrent = atoi(v[SK_OL]);
   }
 
   //apply macro (deprecated, added for compatibility with pre-0.11 automations)
-  pos = req.indexOf(F("&M="));
-  if (pos > 0) {
-    applyPreset(getNumVal(&req, pos) + 16);
+  if (v[SK_M]) {
+    applyPreset(atoi(v[SK_M]) + 16);
   }
 
   //toggle send UDP direct notifications
-  pos = req.indexOf(F("SN="));
-  if (pos > 0) notifyDirect = (req.charAt(pos+3) != '0');
+  if (v[SK_SN]) notifyDirect = (v[SK_SN][0] != '0');
 
   //toggle receive UDP direct notifications
-  pos = req.indexOf(F("RN="));
-  if (pos > 0) receiveNotifications = (req.charAt(pos+3) != '0');
+  if (v[SK_RN]) receiveNotifications = (v[SK_RN][0] != '0');
 
   //receive live data via UDP/Hyperion
-  pos = req.indexOf(F("RD="));
-  if (pos > 0) receiveDirect = (req.charAt(pos+3) != '0');
+  if (v[SK_RD]) receiveDirect = (v[SK_RD][0] != '0');
 
   //main toggle on/off (parse before nightlight, #1214)
-  pos = req.indexOf(F("&T="));
-  if (pos > 0) {
+  if (v[SK_T]) {
     nightlightActive = false; //always disable nightlight when toggling
-    switch (getNumVal(&req, pos))
+    switch (atoi(v[SK_T]))
     {
       case 0: if (bri != 0){briLast = bri; bri = 0;} break; //off, only if it was previously on
       case 1: if (bri == 0) bri = briLast; break; //on, only if it was previously off
@@ -878,17 +825,15 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //toggle nightlight mode
-  bool aNlDef = false;
-  if (req.indexOf(F("&ND")) > 0) aNlDef = true;
-  pos = req.indexOf(F("NL="));
-  if (pos > 0)
+  bool aNlDef = v[SK_ND];
+  if (v[SK_NL])
   {
-    if (req.charAt(pos+3) == '0')
+    if (v[SK_NL][0] == '0')
     {
       nightlightActive = false;
     } else {
       nightlightActive = true;
-      if (!aNlDef) nightlightDelayMins = getNumVal(&req, pos);
+      if (!aNlDef) nightlightDelayMins = atoi(v[SK_NL]);
       nightlightStartTime = millis();
     }
   } else if (aNlDef)
@@ -898,74 +843,65 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply)
   }
 
   //set nightlight target brightness
-  pos = req.indexOf(F("NT="));
-  if (pos > 0) {
-    nightlightTargetBri = getNumVal(&req, pos);
+  if (v[SK_NT]) {
+    nightlightTargetBri = atoi(v[SK_NT]);
     nightlightActiveOld = false; //re-init
   }
 
   //toggle nightlight fade
-  pos = req.indexOf(F("NF="));
-  if (pos > 0)
+  if (v[SK_NF])
   {
-    nightlightMode = getNumVal(&req, pos);
+    nightlightMode = atoi(v[SK_NF]);
 
     nightlightActiveOld = false; //re-init
   }
   if (nightlightMode > NL_MODE_SUN) nightlightMode = NL_MODE_SUN;
 
-  pos = req.indexOf(F("TT="));
-  if (pos > 0) transitionDelay = getNumVal(&req, pos);
+  if (v[SK_TT]) transitionDelay = atoi(v[SK_TT]);
 
   //set time (unix timestamp)
-  pos = req.indexOf(F("ST="));
-  if (pos > 0) {
-    setTimeFromAPI(getNumVal(&req, pos));
+  if (v[SK_ST]) {
+    setTimeFromAPI(strtoul(v[SK_ST], nullptr, 10));
   }
 
   //set countdown goal (unix timestamp)
-  pos = req.indexOf(F("CT="));
-  if (pos > 0) {
-    countdownTime = getNumVal(&req, pos);
+  if (v[SK_CT]) {
+    countdownTime = strtoul(v[SK_CT], nullptr, 10);
     if (countdownTime - toki.second() > 0) countdownOverTriggered = false;
   }
 
-  pos = req.indexOf(F("LO="));
-  if (pos > 0) {
-    realtimeOverride = getNumVal(&req, pos);
+  if (v[SK_LO]) {
+    realtimeOverride = atoi(v[SK_LO]);
     if (realtimeOverride > 2) realtimeOverride = REALTIME_OVERRIDE_ALWAYS;
-    if (realtimeMode && useMainSegmentOnly) {
+    if (realtimeMode && realtimeRoutesActive()) {
+      freezeRealtimeRoutes(!realtimeOverride, false, realtimeMode);
+    } else if (realtimeMode && useMainSegmentOnly) {
       strip.getMainSegment().setOption(SEG_OPTION_FREEZE, !realtimeOverride, strip.getMainSegmentId());
     }
   }
 
-  pos = req.indexOf(F("RB"));
-  if (pos > 0) doReboot = true;
+  if (v[SK_RB]) doReboot = true;
 
   // clock mode, 0: normal, 1: countdown
-  pos = req.indexOf(F("NM="));
-  if (pos > 0) countdownMode = (req.charAt(pos+3) != '0');
+  if (v[SK_NM]) countdownMode = (v[SK_NM][0] != '0');
 
-  pos = req.indexOf(F("U0=")); //user var 0
-  if (pos > 0) {
-    userVar0 = getNumVal(&req, pos);
+  if (v[SK_U0]) { //user var 0
+    userVar0 = atoi(v[SK_U0]);
   }
 
-  pos = req.indexOf(F("U1=")); //user var 1
-  if (pos > 0) {
-    userVar1 = getNumVal(&req, pos);
+  if (v[SK_U1]) { //user var 1
+    userVar1 = atoi(v[SK_U1]);
   }
   // you can add more if you need
 
   // global col[], effectCurrent, ... are updated in stateChanged()
   if (!apply) return true; // when called by JSON API, do not call colorUpdated() here
 
-  pos = req.indexOf(F("&NN")); //do not send UDP notifications this time
-  stateUpdated((pos > 0) ? CALL_MODE_NO_NOTIFY : CALL_MODE_DIRECT_CHANGE);
+  //"&NN": do not send UDP notifications this time
+  stateUpdated(v[SK_NN] ? CALL_MODE_NO_NOTIFY : CALL_MODE_DIRECT_CHANGE);
 
   // internal call, does not send XML response
-  pos = req.indexOf(F("IN"));
-  if (pos < 1) XML_response(request);
+  if (!v[SK_IN]) XML_response(request);
 
   return true;
 }
@@ -38,9 +38,12 @@ ESPAsyncE131::ESPAsyncE131(e131_packet_callback_function callback) {
 //
 /////////////////////////////////////////////////////////
 
-bool ESPAsyncE131::begin(bool multicast, uint16_t port, uint16_t universe, uint8_t n) {
+bool ESPAsyncE131::begin(bool multicast, uint16_t port, uint16_t universe, uint16_t n) {
   bool success = false;
 
+  if (_joined > 1) joinUniverses(1, _joined, false);
+  _joined = 0;
+
   if (multicast) {
 		success = initMulticast(port, universe, n);
 	} else {
@@ -66,23 +69,16 @@ bool ESPAsyncE131::initUnicast(uint16_t port) {
   return success;
 }
 
-bool ESPAsyncE131::initMulticast(uint16_t port, uint16_t universe, uint8_t n) {
+bool ESPAsyncE131::initMulticast(uint16_t port, uint16_t universe, uint16_t n) {
   bool success = false;
 
   IPAddress address = IPAddress(239, 255, ((universe >> 8) & 0xff),
     ((universe >> 0) & 0xff));
 
   if (udp.listenMulticast(address, port)) {
-    ip4_addr_t ifaddr;
-    ip4_addr_t multicast_addr;
-
-    ifaddr.addr = static_cast<uint32_t>(Network.localIP());
-    for (uint8_t i = 1; i < n; i++) {
-        multicast_addr.addr = static_cast<uint32_t>(IPAddress(239, 255,
-          (((universe + i) >> 8) & 0xff), (((universe + i) >> 0)
-          & 0xff)));
-      igmp_joingroup(&ifaddr, &multicast_addr);
-    }
+    _universe = universe;
+    _joined = 1;
+    setUniverseCount(n);
 
     udp.onPacket(std::bind(&ESPAsyncE131::parsePacket, this, std::placeholders::_1));
 
@@ -91,6 +87,36 @@ bool ESPAsyncE131::initMulticast(uint16_t port, uint16_t universe, uint8_t n) {
   return success;
 }
 
+// Joins (or leaves) the groups of universes [_universe + from, _universe + to)
+void ESPAsyncE131::joinUniverses(uint16_t from, uint16_t to, bool join) {
+  ip4_addr_t ifaddr;
+  ip4_addr_t multicast_addr;
+
+  ifaddr.addr = static_cast<uint32_t>(Network.localIP());
+  for (uint16_t i = from; i < to; i++) {
+    uint16_t universe = _universe + i;
+    multicast_addr.addr = static_cast<uint32_t>(IPAddress(239, 255,
+      ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)));
+    if (join) {
+      if (igmp_joingroup(&ifaddr, &multicast_addr) != ERR_OK) {
+        // out of IGMP groups, receive what we have
+        to = i;
+        break;
+      }
+    } else {
+      igmp_leavegroup(&ifaddr, &multicast_addr);
+    }
+  }
+  _joined = join ? to : from;
+}
+
+void ESPAsyncE131::setUniverseCount(uint16_t n) {
+  if (!_joined) return; // not listening for multicast
+  if (n < 1) n = 1;
+  if (n > _joined) joinUniverses(_joined, n, true);
+  else if (n < _joined) joinUniverses(n, _joined, false);
+}
+
 /////////////////////////////////////////////////////////
 //
 // Packet parsing - Private
@@ -110,8 +136,15 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
 	if (protocol == P_ARTNET) {
 		if (memcmp(sbuff->art_id, ESPAsyncE131::ART_ID, sizeof(sbuff->art_id)))
 			error = true; //not "Art-Net"
-		if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX)
+		if (sbuff->art_opcode == ARTNET_OPCODE_OPSYNC)
+			protocol = P_ARTNET_SYNC;
+		else if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX)
 			error = true; //not a DMX packet
+	} else if (htonl(sbuff->root_vector) == ESPAsyncE131::VECTOR_ROOT_EXTENDED) {
+		if (htonl(sbuff->sync_vector) == ESPAsyncE131::VECTOR_FRAME_SYNC)
+			protocol = P_E131_SYNC;
+		else
+			error = true; //universe discovery
 	} else { //E1.31 error handling
 		if (htonl(sbuff->root_vector) != ESPAsyncE131::VECTOR_ROOT)
 			error = true;
@@ -129,6 +162,7 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
   }
 
   if (!error) {
+    _remotePort = _packet.remotePort();
     _callback(sbuff, _packet.remoteIP(), protocol);
   }
 }
\ No newline at end of file
@@ -51,13 +51,39 @@ typedef struct ip_addr ip4_addr_t;
 #define DDP_DEFAULT_PORT    4048
 
 #define DDP_PUSH_FLAG 0x01
+#define DDP_QUERY_FLAG 0x02
+#define DDP_REPLY_FLAG 0x04
+#define DDP_STORAGE_FLAG 0x08
 #define DDP_TIMECODE_FLAG 0x10
-
-#define ARTNET_OPCODE_OPDMX 0x5000
-
-#define P_E131   0
-#define P_ARTNET 1
-#define P_DDP    2
+#define DDP_VERSION_MASK 0xC0
+#define DDP_VERSION_1 0x40
+
+#define DDP_HEADER_LEN 10
+
+//data type byte: C R TTT SSS (customer flag, reserved, element type, element size)
+#define DDP_TYPE_CUSTOM 0x80
+#define DDP_TYPE(t) (((t) >> 3) & 0x07)
+#define DDP_TYPE_SIZE(t) ((t) & 0x07)
+#define DDP_TYPE_UNDEF 0
+#define DDP_TYPE_RGB 1
+#define DDP_TYPE_HSL 2
+#define DDP_TYPE_RGBW 3
+#define DDP_TYPE_GRAY 4
+#define DDP_SIZE_8BIT 3
+
+#define DDP_ID_DISPLAY 1
+#define DDP_ID_CONFIG 250
+#define DDP_ID_STATUS 251
+#define DDP_ID_ALL 255
+
+#define ARTNET_OPCODE_OPDMX  0x5000
+#define ARTNET_OPCODE_OPSYNC 0x5200
+
+#define P_E131        0
+#define P_ARTNET      1
+#define P_DDP         2
+#define P_E131_SYNC   3 //E1.31 synchronization packet
+#define P_ARTNET_SYNC 4 //ArtSync
 
 // E1.31 Packet Offsets
 #define E131_ROOT_PREAMBLE_SIZE 0
@@ -100,7 +126,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address;    //synchronization universe (E1.31-2016), 0 = none
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -127,6 +153,15 @@ typedef union {
     uint8_t  art_data[512];
   } __attribute__((packed));
 
+  struct { //E1.31 synchronization packet
+    uint8_t  sync_root[38];     //root layer, same as above
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;     //synchronization address
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
   struct { //DDP Header
     uint8_t flags;
     uint8_t sequenceNum;
@@ -160,25 +195,40 @@ class ESPAsyncE131 {
     static const uint8_t ACN_ID[];
 	  static const uint8_t ART_ID[];
     static const uint32_t VECTOR_ROOT = 4;
+    static const uint32_t VECTOR_ROOT_EXTENDED = 8;
     static const uint32_t VECTOR_FRAME = 2;
+    static const uint32_t VECTOR_FRAME_SYNC = 1;
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
 
     // Internal Initializers
     bool initUnicast(uint16_t port);
-    bool initMulticast(uint16_t port, uint16_t universe, uint8_t n = 1);
+    bool initMulticast(uint16_t port, uint16_t universe, uint16_t n = 1);
+    void joinUniverses(uint16_t from, uint16_t to, bool join);
 
     // Packet parser callback
     void parsePacket(AsyncUDPPacket _packet);
     
     e131_packet_callback_function _callback = nullptr;
+    uint16_t _remotePort = 0;
+    uint16_t _universe = 1;
+    uint16_t _joined = 0;       // multicast groups joined, starting at _universe
 
  public:
     ESPAsyncE131(e131_packet_callback_function callback);
 
     // Generic UDP listener, no physical or IP configuration
-    bool begin(bool multicast, uint16_t port = E131_DEFAULT_PORT, uint16_t universe = 1, uint8_t n = 1);
+    bool begin(bool multicast, uint16_t port = E131_DEFAULT_PORT, uint16_t universe = 1, uint16_t n = 1);
+
+    // Joins or leaves multicast groups so that n universes are received (no-op for unicast)
+    void setUniverseCount(uint16_t n);
+
+    // Source port of the packet passed to the callback (for replies)
+    uint16_t remotePort() { return _remotePort; }
+
+    // Sends a packet from the listening port (DDP replies)
+    size_t writeTo(const uint8_t* data, size_t len, IPAddress ip, uint16_t port) { return udp.writeTo(data, len, ip, port); }
 };
 
 #endif  // ESPASYNCE131_H_
\ No newline at end of file
@@ -10,6 +10,388 @@
 #define UDP_IN_MAXSIZE 1472
 #define PRESUMED_NETWORK_DELAY 3 //how many ms could it take on avg to reach the receiver? This will be added to transmitted times
 
+static byte* udpIn = nullptr; //receive buffer, allocated on first packet and reused
+
+static bool allocUdpIn() {
+  if (udpIn == nullptr) udpIn = (byte*)malloc(UDP_IN_MAXSIZE +1);
+  return udpIn != nullptr;
+}
+
+/*
+ * Realtime input statistics, indexed by realtime mode (one per protocol)
+ */
+#define RT_STAT_MODES 9
+#define RT_STAT_BUCKETS 8
+#define RT_STAT_REPLIES 2 //statistics replies per second
+static const uint16_t rtStatEdges[RT_STAT_BUCKETS -1] = {1, 2, 5, 10, 20, 50, 100}; //latency histogram bucket limits in ms
+
+struct RealtimeStat {
+  uint32_t packets, frames, bytes, drops, torn, errors;
+  uint32_t lastPackets, lastFrames, lastBytes;
+  uint32_t pps, fps, bps;           //rates of the last second
+  uint32_t gapWin, gap, gapMax;     //max inter-arrival time in us: current second, last second, overall
+  uint32_t lastRx;                  //micros() of the last packet
+  uint32_t hist[RT_STAT_BUCKETS];   //packet receipt to show() latency
+};
+static RealtimeStat rtStats[RT_STAT_MODES];
+static const char* const rtStatNames[RT_STAT_MODES] = {"", "generic", "udp", "hyperion", "e131", "adalight", "artnet", "tpm2net", "ddp"};
+static uint32_t rtFrameRx = 0;      //micros() of the first packet of the frame being received
+static unsigned long rtStatsUpdated = 0;
+
+void realtimeStatPacket(byte mode, uint16_t bytes) {
+  if (mode >= RT_STAT_MODES) return;
+  RealtimeStat& st = rtStats[mode];
+  uint32_t now = micros();
+  uint32_t gap = now - st.lastRx;
+  if (st.lastRx && gap < realtimeTimeoutMs * 1000) {
+    if (gap > st.gapWin) st.gapWin = gap;
+    if (gap > st.gapMax) st.gapMax = gap;
+  }
+  st.lastRx = now;
+  st.packets++;
+  st.bytes += bytes;
+  if (!rtFrameRx) rtFrameRx = now;
+}
+
+void realtimeStatDrop(byte mode) {
+  if (mode < RT_STAT_MODES) rtStats[mode].drops++;
+}
+
+void realtimeStatTorn(byte mode) {
+  if (mode < RT_STAT_MODES) rtStats[mode].torn++;
+}
+
+//checksum or framing error, the frame was discarded
+void realtimeStatError(byte mode) {
+  if (mode < RT_STAT_MODES) rtStats[mode].errors++;
+}
+
+static void realtimeStatLatency(byte mode, uint32_t us) {
+  if (mode >= RT_STAT_MODES) return;
+  uint32_t ms = us / 1000;
+  uint8_t b = 0;
+  while (b < RT_STAT_BUCKETS -1 && ms >= rtStatEdges[b]) b++;
+  rtStats[mode].frames++;
+  rtStats[mode].hist[b]++;
+}
+
+//frame of the current stream was shown
+void realtimeStatFrame(byte mode) {
+  if (rtFrameRx) realtimeStatLatency(mode, micros() - rtFrameRx);
+  else if (mode < RT_STAT_MODES) rtStats[mode].frames++;
+  rtFrameRx = 0;
+}
+
+static void updateRealtimeStats() {
+  if (millis() - rtStatsUpdated < 1000) return;
+  rtStatsUpdated = millis();
+  for (uint8_t m = 0; m < RT_STAT_MODES; m++) {
+    RealtimeStat& st = rtStats[m];
+    st.pps = st.packets - st.lastPackets; st.lastPackets = st.packets;
+    st.fps = st.frames  - st.lastFrames;  st.lastFrames  = st.frames;
+    st.bps = st.bytes   - st.lastBytes;   st.lastBytes   = st.bytes;
+    st.gap = st.gapWin; st.gapWin = 0;
+  }
+}
+
+//adds an object per protocol that received data, gaps are in ms
+void serializeRealtimeStats(JsonObject root) {
+  for (uint8_t m = 1; m < RT_STAT_MODES; m++) {
+    RealtimeStat& st = rtStats[m];
+    if (!st.packets) continue;
+    JsonObject p = root.createNestedObject(rtStatNames[m]);
+    p[F("pps")]    = st.pps;
+    p[F("fps")]    = st.fps;
+    p[F("bps")]    = st.bps;
+    p[F("pkts")]   = st.packets;
+    p[F("frames")] = st.frames;
+    p[F("drops")]  = st.drops;
+    p[F("torn")]   = st.torn;
+    p[F("err")]    = st.errors;
+    p[F("gap")]    = st.gap / 1000;
+    p[F("gapmax")] = st.gapMax / 1000;
+    JsonArray lat = p.createNestedArray(F("lat")); //frames per latency bucket <1,<2,<5,<10,<20,<50,<100,>=100 ms
+    for (uint8_t b = 0; b < RT_STAT_BUCKETS; b++) lat.add(st.hist[b]);
+  }
+}
+
+//the reply is much larger than the 2 byte request: only the local subnet is answered, and rate limited,
+//so requests with a spoofed sender cannot use it for amplification
+static bool realtimeStatsAllowed(IPAddress ip) {
+  static TokenBucket replies(RT_STAT_REPLIES, RT_STAT_REPLIES);
+  uint32_t nm = Network.subnetMask();
+  if ((uint32_t(ip) & nm) != (uint32_t(Network.localIP()) & nm)) return false;
+  return replies.take(millis());
+}
+
+//answers a realtime statistics request (255, 2) with the JSON of serializeRealtimeStats(),
+//printed into the receive buffer. Protocols that do not fit into one packet are left out
+static void sendRealtimeStats(WiFiUDP& udp) {
+  if (!realtimeStatsAllowed(udp.remoteIP())) return;
+  char* out = (char*)udpIn;
+  const size_t cap = UDP_IN_MAXSIZE - 2; //room for the closing braces
+  size_t len = strlcpy_P(out, PSTR("{\"rt\":{"), cap);
+  bool first = true;
+  for (uint8_t m = 1; m < RT_STAT_MODES; m++) {
+    RealtimeStat& st = rtStats[m];
+    if (!st.packets) continue;
+    size_t start = len;
+    len += snprintf_P(out + len, cap - len,
+      PSTR("%s\"%s\":{\"pps\":%u,\"fps\":%u,\"bps\":%u,\"pkts\":%u,\"frames\":%u,\"drops\":%u,\"torn\":%u,\"err\":%u,\"gap\":%u,\"gapmax\":%u,\"lat\":["),
+      first ? "" : ",", rtStatNames[m], st.pps, st.fps, st.bps, st.packets, st.frames, st.drops, st.torn, st.errors, st.gap / 1000, st.gapMax / 1000);
+    for (uint8_t b = 0; b < RT_STAT_BUCKETS && len < cap; b++) {
+      len += snprintf_P(out + len, cap - len, PSTR("%s%u"), b ? "," : "", st.hist[b]);
+    }
+    if (len < cap) len += snprintf_P(out + len, cap - len, PSTR("]}"));
+    if (len >= cap) { len = start; break; } //did not fit
+    first = false;
+  }
+  out[len++] = '}'; out[len++] = '}';
+  if (!udp.beginPacket(udp.remoteIP(), udp.remotePort())) return;
+  udp.write(udpIn, len);
+  udp.endPacket();
+}
+
+/*
+ * Realtime frame buffering. With a jitter buffer (rtBufFrames > 0) or interpolation (rtInterpolate),
+ * realtime writes go to a staging frame instead of the strip. Completed frames are queued and played out
+ * at the sender's frame rate rtBufLatency ms after arrival, and/or blended into in-between frames by service().
+ */
+static byte* rtStage = nullptr;       //frame being received, RGBW per pixel (arlsOffset applied, no gamma)
+static byte* rtQueue = nullptr;       //ring of rtSlots frames
+static byte* rtPrev = nullptr;        //interpolation start and end frame
+static byte* rtCur = nullptr;
+static uint8_t rtSlots = 0, rtHead = 0, rtCount = 0, rtWanted = 0;
+static bool rtInterpWanted = false;
+static uint16_t rtFrameLen = 0;
+static uint32_t rtArrival[RT_BUFFER_MAX_FRAMES];
+static unsigned long rtNextDue = 0;   //playout time of the queue head, 0 = wait for the next frame
+static uint8_t rtDueFrac = 0;         //1/16 ms remainder of rtNextDue
+static uint32_t rtInterval16 = 0;     //frame interval in 1/16 ms
+static uint32_t rtLastStamp = 0, rtStamp = 0;
+static unsigned long rtCurAt = 0;     //time rtCur was presented
+static bool rtInterpDone = true;      //rtCur has been shown unblended
+
+//the buffers are only (re)allocated and freed by the loop, in updateRealtimeBuffer().
+//E1.31/Art-Net/DDP write the staging frame from the async UDP task on ESP32, so these writes
+//and the stage to queue copy hold rtStageMutex. A mutex, not a critical section: copying
+//a frame of a few thousand pixels must not keep interrupts and the other core waiting
+#ifdef ARDUINO_ARCH_ESP32
+static SemaphoreHandle_t rtStageMutex = nullptr; //created by the loop before the first stage is set
+#define RT_STAGE_LOCK()   xSemaphoreTake(rtStageMutex, portMAX_DELAY)
+#define RT_STAGE_UNLOCK() xSemaphoreGive(rtStageMutex)
+#else
+#define RT_STAGE_LOCK()
+#define RT_STAGE_UNLOCK()
+#endif
+
+static void freeRealtimeBuffer() {
+  RT_STAGE_LOCK();
+  byte* stage = rtStage;
+  rtStage = nullptr; //writers go to the strip directly from now on
+  RT_STAGE_UNLOCK();
+  free(stage);
+  free(rtQueue);
+  free(rtPrev);
+  free(rtCur);
+  rtQueue = rtPrev = rtCur = nullptr;
+  rtSlots = rtCount = rtHead = 0;
+  rtNextDue = 0; rtInterval16 = 0; rtLastStamp = 0; rtStamp = 0;
+  rtInterpDone = true;
+}
+
+static byte* allocFrames(uint32_t size, bool psram) {
+  #ifdef ARDUINO_ARCH_ESP32
+  if (psram) return (byte*)ps_calloc(size, 1);
+  #endif
+  return (byte*)calloc(size, 1);
+}
+
+static void allocRealtimeBuffer() {
+  uint16_t len = strip.getLengthTotal();
+  #ifdef ARDUINO_ARCH_ESP32
+  if (!rtStageMutex && !(rtStageMutex = xSemaphoreCreateMutex())) return;
+  #endif
+  freeRealtimeBuffer();
+  rtWanted = rtBufFrames;
+  rtInterpWanted = rtInterpolate;
+  rtFrameLen = len;
+  uint32_t frame = len * 4;
+  uint32_t maxMem = RT_BUFFER_MAX_MEM;
+  bool psram = false;
+  #ifdef ARDUINO_ARCH_ESP32
+  if (psramFound()) { maxMem = RT_BUFFER_MAX_PSRAM; psram = true; }
+  #endif
+  uint8_t fixed = rtInterpolate ? 3 : 1; //staging plus interpolation frames
+  if (!frame || maxMem / frame < fixed) return;
+  uint32_t slots = maxMem / frame - fixed;
+  if (slots > rtBufFrames) slots = rtBufFrames;
+  if (slots > RT_BUFFER_MAX_FRAMES) slots = RT_BUFFER_MAX_FRAMES;
+  if (!slots && !rtInterpolate) return;
+
+  byte* stage = allocFrames(frame, psram);
+  bool ok = stage;
+  if (slots) ok = ok && (rtQueue = allocFrames(frame * slots, psram));
+  if (rtInterpolate) ok = ok && (rtPrev = allocFrames(frame, psram)) && (rtCur = allocFrames(frame, psram));
+  if (!ok) {
+    DEBUG_PRINTLN(F("Not enough memory for realtime buffer."));
+    free(stage);
+    freeRealtimeBuffer();
+    return;
+  }
+  rtSlots = slots;
+  RT_STAGE_LOCK();
+  rtStage = stage;
+  RT_STAGE_UNLOCK();
+}
+
+//called by the loop only: allocates the buffers while in realtime mode with buffering or interpolation enabled,
+//reallocates them if the LED count or the settings change and frees them once realtime mode ends
+static void updateRealtimeBuffer() {
+  if (!realtimeMode || (!rtBufFrames && !rtInterpolate)) {
+    if (rtFrameLen) { freeRealtimeBuffer(); rtWanted = 0; rtInterpWanted = false; rtFrameLen = 0; }
+    return;
+  }
+  //a failed allocation is not retried until something changes
+  if (rtWanted == rtBufFrames && rtInterpWanted == rtInterpolate && rtFrameLen == strip.getLengthTotal()) return;
+  allocRealtimeBuffer();
+}
+
+//staging frame, locked for writing. nullptr (not locked) if realtime data goes to the strip directly
+static byte* lockRealtimeStage() {
+  #ifdef ARDUINO_ARCH_ESP32
+  if (!rtStageMutex) return nullptr;
+  #endif
+  RT_STAGE_LOCK();
+  if (rtStage) return rtStage;
+  RT_STAGE_UNLOCK();
+  return nullptr;
+}
+
+//copies the received frame out of the staging frame, the next one may already be arriving
+static void takeRealtimeStage(byte* dst) {
+  RT_STAGE_LOCK();
+  if (rtStage) memcpy(dst, rtStage, rtFrameLen * 4);
+  RT_STAGE_UNLOCK();
+}
+
+//sender time of the frame being received in ms (e.g. from a DDP timecode), used for the frame interval instead of its arrival time
+void setRealtimeFrameStamp(uint32_t ms) {
+  rtStamp = ms;
+}
+
+static void measureRealtimeInterval(unsigned long now) {
+  uint32_t stamp = rtStamp ? rtStamp : now;
+  uint32_t d = stamp - rtLastStamp;
+  if (rtLastStamp && d > 0 && d < 1000) rtInterval16 = rtInterval16 ? (rtInterval16 * 7 + d * 16) / 8 : d * 16;
+  rtLastStamp = stamp;
+  rtStamp = 0;
+  rtBufInterval = rtInterval16 >> 4;
+}
+
+static void writeRealtimeFrame(const byte* frame) {
+  bool gamma = !arlsDisableGammaCorrection && strip.gammaCorrectCol;
+  strip.writeSpan(0, frame, rtFrameLen, 4, gamma ? strip.getGammaTable() : nullptr);
+}
+
+//rotates the interpolation frames, the frame copied to the returned buffer is blended in by service()
+static byte* nextInterpolationTarget() {
+  byte* t = rtPrev; rtPrev = rtCur; rtCur = t;
+  rtCurAt = millis();
+  rtInterpDone = false;
+  return rtCur;
+}
+
+//shows a complete frame, or makes it the new interpolation target
+static void presentRealtimeFrame(const byte* frame) {
+  if (rtCur) {
+    memcpy(nextInterpolationTarget(), frame, rtFrameLen * 4);
+    return; //rendered by service()
+  }
+  if (realtimeOverride) return;
+  writeRealtimeFrame(frame);
+  strip.show();
+}
+
+static void queueRealtimeFrame() {
+  unsigned long now = millis();
+  measureRealtimeInterval(now);
+  if (!rtSlots) { //interpolation only
+    takeRealtimeStage(nextInterpolationTarget());
+    realtimeStatFrame(realtimeMode);
+    return;
+  }
+
+  uint32_t frame = rtFrameLen * 4;
+  if (rtCount == rtSlots) { //full, drop the oldest frame
+    rtHead = (rtHead + 1) % rtSlots;
+    rtCount--;
+    rtBufOverruns++;
+  }
+  uint8_t tail = (rtHead + rtCount) % rtSlots;
+  takeRealtimeStage(rtQueue + tail * frame);
+  rtArrival[tail] = now;
+  rtFrameRx = 0; //latency is taken at playout
+  rtCount++;
+  if (!rtNextDue) { rtNextDue = now + rtBufLatency; rtDueFrac = 0; }
+}
+
+//presents the queue head once it is due, playout speed is nudged to keep the latency near rtBufLatency
+static void playRealtimeFrame() {
+  if (!rtNextDue || !rtSlots) return;
+  unsigned long now = millis();
+  if ((long)(now - rtNextDue) < 0) return;
+  if (!rtCount) { //ran dry, start over with the next frame
+    rtBufUnderruns++;
+    rtNextDue = 0;
+    return;
+  }
+  presentRealtimeFrame(rtQueue + rtHead * rtFrameLen * 4);
+  uint32_t lat = now - rtArrival[rtHead];
+  realtimeStatLatency(realtimeMode, lat * 1000);
+  rtBufLatencyAvg = (rtBufLatencyAvg * 7 + lat) / 8;
+  rtHead = (rtHead + 1) % rtSlots;
+  rtCount--;
+
+  uint32_t interval = rtInterval16 >> 4;
+  uint32_t step = rtInterval16 ? rtInterval16 : 16;
+  if (lat > rtBufLatency + interval) step -= step / 8;
+  else if (lat + interval < rtBufLatency) step += step / 8;
+  rtDueFrac += step & 15;
+  rtNextDue += (step >> 4) + (rtDueFrac >> 4);
+  rtDueFrac &= 15;
+}
+
+//called by WS2812FX::service() once per frame, writes the blend of the last two realtime frames
+//for the current time to the strip. Returns false if there is nothing new to show
+bool renderRealtimeFrame() {
+  if (!rtCur || rtInterpDone || realtimeOverride) return false;
+  uint32_t elapsed = millis() - rtCurAt;
+  uint32_t interval = rtInterval16 >> 4;
+  uint16_t t = 256;
+  if (interval && elapsed < interval) t = (elapsed << 8) / interval;
+  if (t >= 256) { //target reached, show it as is
+    writeRealtimeFrame(rtCur);
+    rtInterpDone = true;
+    return true;
+  }
+
+  //blend contiguous chunks: out = prev + (cur - prev) * t
+  byte out[256];
+  bool gamma = !arlsDisableGammaCorrection && strip.gammaCorrectCol;
+  const uint8_t* lut = gamma ? strip.getGammaTable() : nullptr;
+  uint32_t total = rtFrameLen * 4;
+  uint16_t inv = 256 - t;
+  for (uint32_t o = 0; o < total; o += sizeof(out)) {
+    uint16_t c = (total - o < sizeof(out)) ? total - o : sizeof(out);
+    const byte* a = rtPrev + o;
+    const byte* b = rtCur + o;
+    for (uint16_t k = 0; k < c; k++) out[k] = (a[k] * inv + b[k] * t) >> 8;
+    strip.writeSpan(o >> 2, out, c >> 2, 4, lut);
+  }
+  return true;
+}
+
 void notify(byte callMode, bool followUp)
 {
   if (!udpConnected) return;
@@ -140,7 +522,10 @@ void notify(byte callMode, bool followUp)
 
 void realtimeLock(uint32_t timeoutMs, byte md)
 {
-  if (!realtimeMode && !realtimeOverride) {
+  if (!realtimeMode && !realtimeOverride && realtimeRoutesActive(md)) {
+    resolveRealtimeRoutes();
+    freezeRealtimeRoutes(true, true, md); //only the routed segments go live
+  } else if (!realtimeMode && !realtimeOverride) {
     uint16_t stop, start;
     if (useMainSegmentOnly) {
       WS2812FX::Segment& mainseg = strip.getMainSegment();
@@ -168,6 +553,7 @@ void realtimeLock(uint32_t timeoutMs, byte md)
   if (realtimeTimeout != UINT32_MAX) {
     realtimeTimeout = (timeoutMs == 255001 || timeoutMs == 65000) ? UINT32_MAX : millis() + timeoutMs;
   }
+  if (realtimeMode != md) { stateGeneration++; infoGeneration++; }
   realtimeMode = md;
 
   if (realtimeOverride) return;
@@ -177,12 +563,17 @@ void realtimeLock(uint32_t timeoutMs, byte md)
 
 void exitRealtime() {
   if (!realtimeMode) return;
+  byte md = realtimeMode;
   if (realtimeOverride == REALTIME_OVERRIDE_ONCE) realtimeOverride = REALTIME_OVERRIDE_NONE;
   strip.setBrightness(scaledBri(bri));
   realtimeTimeout = 0; // cancel realtime mode immediately
   realtimeMode = REALTIME_MODE_INACTIVE; // inform UI immediately
-  realtimeIP[0] = 0;
-  if (useMainSegmentOnly) { // unfreeze live segment again
+  stateGeneration++; infoGeneration++;
+  realtimeIP[0] = 0; //buffers are freed by the loop (may be called from the async webserver)
+  rtFrameRx = 0;
+  if (realtimeRoutesActive(md)) { // unfreeze routed segments
+    freezeRealtimeRoutes(false, false, md);
+  } else if (useMainSegmentOnly) { // unfreeze live segment again
     strip.getMainSegment().setOption(SEG_OPTION_FREEZE, false, strip.getMainSegmentId());
   }
 }
@@ -198,27 +589,10 @@ void sendTPM2Ack() {
 }
 
 
-void handleNotifications()
+//reads and handles one pending packet, returns false if there was none
+static bool handleUdpPacket()
 {
   IPAddress localIP;
-
-  //send second notification if enabled
-  if(udpConnected && notificationTwoRequired && millis()-notificationSentTime > 250){
-    notify(notificationSentCallMode,true);
-  }
-  
-  if (e131NewData && millis() - strip.getLastShow() > 15)
-  {
-    e131NewData = false;
-    strip.show();
-  }
-
-  //unlock strip when realtime UDP times out
-  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
-
-  //receive UDP notifications
-  if (!udpConnected) return;
-    
   bool isSupp = false;
   uint16_t packetSize = notifierUdp.parsePacket();
   if (!packetSize && udp2Connected) {
@@ -230,41 +604,43 @@ void handleNotifications()
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
-      if (!receiveDirect) return;
-      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
+      if (!receiveDirect) return true;
+      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return true;
+      if (!allocUdpIn()) return true;
+      realtimeStatPacket(REALTIME_MODE_HYPERION, packetSize);
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
-      uint8_t lbuf[packetSize];
-      rgbUdp.read(lbuf, packetSize);
+      rgbUdp.read(udpIn, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride) return;
-      uint16_t id = 0;
-      uint16_t totalLen = strip.getLengthTotal();
-      for (uint16_t i = 0; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-        id++; if (id >= totalLen) break;
-      }
-      strip.show();
-      return;
+      if (realtimeOverride) return true;
+      setRealtimePixels(0, udpIn, packetSize /3, 3);
+      e131NewData = true;
+      return true;
     } 
   }
+  if (!packetSize) return false;
 
-  if (!(receiveNotifications || receiveDirect)) return;
+  if (!(receiveNotifications || receiveDirect)) return true;
   
   localIP = Network.localIP();
   //notifier and UDP realtime
-  if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
-  if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
+  if (packetSize > UDP_IN_MAXSIZE) return true;
+  if (!isSupp && notifierUdp.remoteIP() == localIP) return true; //don't process broadcasts we send ourselves
+  if (!allocUdpIn()) return true;
 
-  uint8_t udpIn[packetSize +1];
   uint16_t len;
   if (isSupp) len = notifier2Udp.read(udpIn, packetSize);
   else        len =  notifierUdp.read(udpIn, packetSize);
 
+  // realtime statistics request
+  if (udpIn[0] == 255 && udpIn[1] == 2 && len >= 2) {
+    sendRealtimeStats(isSupp ? notifier2Udp : notifierUdp);
+    return true;
+  }
+
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
-    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
+    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return true;
 
     uint8_t unit = udpIn[39];
     NodesMap::iterator it = Nodes.find(unit);
@@ -290,15 +666,15 @@ void handleNotifications()
           build |= udpIn[40+i]<<(8*i);
       it->second.build = build;
     }
-    return;
+    return true;
   }
 
   //wled notifier, ignore if realtime packets active
   if (udpIn[0] == 0 && !realtimeMode && receiveNotifications)
   {
     //ignore notification if received within a second after sending a notification ourselves
-    if (millis() - notificationSentTime < 1000) return;
-    if (udpIn[1] > 199) return; //do not receive custom versions
+    if (millis() - notificationSentTime < 1000) return true;
+    if (udpIn[1] > 199) return true; //do not receive custom versions
 
     //compatibilityVersionByte: 
     byte version = udpIn[11];
@@ -306,8 +682,8 @@ void handleNotifications()
     // if we are not part of any sync group ignore message
     if (version < 9 || version > 199) {
       // legacy senders are treated as if sending in sync group 1 only
-      if (!(receiveGroups & 0x01)) return;
-    } else if (!(receiveGroups & udpIn[36])) return;
+      if (!(receiveGroups & 0x01)) return true;
+    } else if (!(receiveGroups & udpIn[36])) return true;
     
     bool someSel = (receiveNotificationBrightness || receiveNotificationColor || receiveNotificationEffects);
 
@@ -430,10 +806,10 @@ void handleNotifications()
     
     if (receiveNotificationBrightness || !someSel) bri = udpIn[2];
     stateUpdated(CALL_MODE_NOTIFICATION);
-    return;
+    return true;
   }
 
-  if (!receiveDirect) return;
+  if (!receiveDirect) return true;
   
   //TPM2.NET
   if (udpIn[0] == 0x9c)
@@ -442,13 +818,14 @@ void handleNotifications()
     //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
     byte tpmType = udpIn[1];
     if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
-      sendTPM2Ack(); return;
+      sendTPM2Ack(); return true;
     }
-    if (tpmType != 0xda) return; //return if notTPM2.NET data
+    if (tpmType != 0xda) return true; //return if notTPM2.NET data
+    realtimeStatPacket(REALTIME_MODE_TPM2NET, packetSize);
 
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
-    if (realtimeOverride) return;
+    if (realtimeOverride) return true;
 
     tpmPacketCount++; //increment the packet count
     if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
@@ -456,101 +833,89 @@ void handleNotifications()
     byte numPackets = udpIn[5];
 
     uint16_t id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-    uint16_t totalLen = strip.getLengthTotal();
-    for (uint16_t i = 6; i < tpmPayloadFrameSize + 4; i += 3)
-    {
-      if (id < totalLen)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-      else break;
-    }
+    uint16_t n = tpmPayloadFrameSize/3;
+    if (packetSize < 6) n = 0;
+    else if (n > (packetSize -6)/3) n = (packetSize -6)/3; //do not read past the packet
+    setRealtimePixels(id, udpIn + 6, n, 3);
     if (tpmPacketCount == numPackets) //reset packet count and show if all packets were received
     {
       tpmPacketCount = 0;
-      strip.show();
+      e131NewData = true;
     }
-    return;
+    return true;
   }
 
-  //UDP realtime: 1 warls 2 drgb 3 drgbw
-  if (udpIn[0] > 0 && udpIn[0] < 5)
+  //UDP realtime: 1 warls 2 drgb 3 drgbw 4 dnrgb 5 dnrgbw
+  if (udpIn[0] > 0 && udpIn[0] < 6)
   {
+    realtimeStatPacket(REALTIME_MODE_UDP, packetSize);
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     DEBUG_PRINTLN(realtimeIP);
-    if (packetSize < 2) return;
+    if (packetSize < 2) return true;
 
     if (udpIn[1] == 0)
     {
       realtimeTimeout = 0;
-      return;
+      return true;
     } else {
       realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
     }
-    if (realtimeOverride) return;
+    if (realtimeOverride) return true;
 
-    uint16_t totalLen = strip.getLengthTotal();
+    UdpRealtimeSpan span;
     if (udpIn[0] == 1) //warls
     {
       for (uint16_t i = 2; i < packetSize -3; i += 4)
       {
         setRealtimePixel(udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3], 0);
       }
-    } else if (udpIn[0] == 2) //drgb
+    } else if (decodeUdpRealtime(udpIn, packetSize, span)) //drgb(w), dnrgb(w)
     {
-      uint16_t id = 0;
-      for (uint16_t i = 2; i < packetSize -2; i += 3)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-
-        id++; if (id >= totalLen) break;
-      }
-    } else if (udpIn[0] == 3) //drgbw
-    {
-      uint16_t id = 0;
-      for (uint16_t i = 2; i < packetSize -3; i += 4)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        
-        id++; if (id >= totalLen) break;
-      }
-    } else if (udpIn[0] == 4) //dnrgb
-    {
-      uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (uint16_t i = 4; i < packetSize -2; i += 3)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        id++;
-      }
-    } else if (udpIn[0] == 5) //dnrgbw
-    {
-      uint16_t id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (uint16_t i = 4; i < packetSize -2; i += 4)
-      {
-        if (id >= totalLen) break;
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        id++;
-      }
+      setRealtimePixels(span.start, span.data, span.count, span.stride);
     }
-    strip.show();
-    return;
+    e131NewData = true;
+    return true;
   }
 
   // API over UDP
   udpIn[packetSize] = '\0';
 
   if (udpIn[0] >= 'A' && udpIn[0] <= 'Z') { //HTTP API
-    String apireq = "win&";
-    apireq += (char*)udpIn;
-    handleSet(nullptr, apireq);
-  } else if (udpIn[0] == '{') { //JSON API
-    DynamicJsonDocument jsonBuffer(2048);
-    DeserializationError error = deserializeJson(jsonBuffer, udpIn);
-    JsonObject root = jsonBuffer.as<JsonObject>();
-    if (!error && !root.isNull()) deserializeState(root);
+    applyRemoteSet((const char*)udpIn, packetSize);
+  } else if (udpIn[0] == '{' || isMsgPackMap(udpIn, packetSize)) { //JSON API, as text or MessagePack map
+    applyRemoteJSON((const char*)udpIn, packetSize);
   }
+  return true;
+}
+
+void handleNotifications()
+{
+  //send second notification if enabled
+  if(udpConnected && notificationTwoRequired && millis()-notificationSentTime > 250){
+    notify(notificationSentCallMode,true);
+  }
+
+  //unlock strip when realtime UDP times out
+  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
+  updateRealtimeBuffer();
+
+  //receive UDP notifications, drain pending packets so multi-packet frames are handled within one loop
+  if (udpConnected) drainPackets(handleUdpPacket, millis, udpMaxPackets, udpMaxMs);
+
+  //show realtime data once (E1.31/Art-Net frame complete, DDP push or UDP realtime)
+  handleE131FrameTimeout();
+  handleDDPPlayout();
+  if (e131NewData)
+  {
+    e131NewData = false;
+    if (rtStage) queueRealtimeFrame();
+    else {
+      strip.show();
+      realtimeStatFrame(realtimeMode);
+    }
+  }
+  playRealtimeFrame();
+  updateRealtimeStats();
 }
 
 
@@ -559,6 +924,15 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   uint16_t pix = i + arlsOffset;
   if (pix < strip.getLengthTotal())
   {
+    byte* st = lockRealtimeStage();
+    if (st) {
+      if (pix < rtFrameLen) { //LED count may have changed, buffer is resized by the next loop
+        st += pix * 4;
+        st[0] = r; st[1] = g; st[2] = b; st[3] = w;
+      }
+      RT_STAGE_UNLOCK();
+      return;
+    }
     if (!arlsDisableGammaCorrection && strip.gammaCorrectCol)
     {
       strip.setPixelColor(pix, strip.gamma8(r), strip.gamma8(g), strip.gamma8(b), strip.gamma8(w));
@@ -568,6 +942,68 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   }
 }
 
+//sets n consecutive pixels to one color, with the same offset and gamma handling as setRealtimePixel()
+void fillRealtimePixels(uint16_t i, uint16_t n, byte r, byte g, byte b, byte w)
+{
+  uint16_t totalLen = strip.getLengthTotal();
+  if (i >= totalLen) return;
+  if (n > totalLen - i) n = totalLen - i;
+  int32_t pix = i + arlsOffset;
+  if (pix < 0) {
+    if (n <= -pix) return;
+    n += pix; pix = 0;
+  }
+  if (pix >= totalLen) return;
+  if (n > totalLen - pix) n = totalLen - pix;
+  byte* st = lockRealtimeStage();
+  if (st) {
+    if (pix < rtFrameLen) {
+      if (n > rtFrameLen - pix) n = rtFrameLen - pix;
+      st += pix * 4;
+      st[0] = r; st[1] = g; st[2] = b; st[3] = w;
+      for (uint16_t x = 1; x < n; x++) memcpy(st + x * 4, st, 4);
+    }
+    RT_STAGE_UNLOCK();
+    return;
+  }
+  if (!arlsDisableGammaCorrection && strip.gammaCorrectCol) {
+    r = strip.gamma8(r); g = strip.gamma8(g); b = strip.gamma8(b); w = strip.gamma8(w);
+  }
+  strip.fillSpan(pix, n, RGBW32(r, g, b, w));
+}
+
+//bulk version of setRealtimePixel() for n consecutive pixels, data is RGB (stride 3) or RGBW (stride 4)
+void setRealtimePixels(uint16_t i, const uint8_t* data, uint16_t n, uint8_t stride)
+{
+  uint16_t totalLen = strip.getLengthTotal();
+  if (i >= totalLen) return;
+  if (n > totalLen - i) n = totalLen - i;
+  int32_t pix = i + arlsOffset;
+  if (pix < 0) { //skip pixels shifted out in front of the strip
+    if (n <= -pix) return;
+    n += pix; data -= pix * stride; pix = 0;
+  }
+  if (pix >= totalLen) return;
+  if (n > totalLen - pix) n = totalLen - pix;
+
+  byte* st = lockRealtimeStage();
+  if (st) {
+    if (pix < rtFrameLen) {
+      if (n > rtFrameLen - pix) n = rtFrameLen - pix;
+      st += pix * 4;
+      for (uint16_t x = 0; x < n; x++, st += 4, data += stride) {
+        st[0] = data[0]; st[1] = data[1]; st[2] = data[2]; st[3] = (stride > 3) ? data[3] : 0;
+      }
+    }
+    RT_STAGE_UNLOCK();
+    return;
+  }
+
+  //gamma is folded into the per bus channel table, no intermediate copy
+  bool gamma = !arlsDisableGammaCorrection && strip.gammaCorrectCol;
+  strip.writeSpan(pix, data, n, stride, gamma ? strip.getGammaTable() : nullptr);
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -643,7 +1079,6 @@ void sendSysInfoUDP()
  * Art-Net, DDP, E131 output - work in progress
 \*********************************************************************************************/
 
-#define DDP_HEADER_LEN 10
 #define DDP_SYNCPACKET_LEN 10
 
 #define DDP_FLAGS1_VER 0xc0  // version mask
@@ -654,10 +1089,6 @@ void sendSysInfoUDP()
 #define DDP_FLAGS1_STORAGE 0x08
 #define DDP_FLAGS1_TIME 0x10
 
-#define DDP_ID_DISPLAY 1
-#define DDP_ID_CONFIG 250
-#define DDP_ID_STATUS 251
-
 // 1440 channels per packet
 #define DDP_CHANNELS_PER_PACKET 1440 // 480 leds
 
@@ -752,3 +1183,33 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, uint8
   }
   return 0;
 }
+
+//answers a DDP status or config query so controllers can discover this node and size their output
+void sendDDPReply(IPAddress client, uint16_t port, uint8_t id, uint8_t seq)
+{
+  if (!(apActive || interfacesInited) || !client[0]) return;
+
+  uint8_t buf[DDP_HEADER_LEN + 200];
+  char* json = (char*)buf + DDP_HEADER_LEN;
+  size_t cap = sizeof(buf) - DDP_HEADER_LEN;
+  int len;
+  if (id == DDP_ID_STATUS) {
+    len = snprintf_P(json, cap, PSTR("{\"status\":{\"man\":\"WLED\",\"mod\":\"%s\",\"ver\":\"%s\",\"mac\":\"%s\"}}"),
+                     serverDescription, versionString, escapedMac.c_str());
+  } else {
+    IPAddress ip = Network.localIP(), nm = Network.subnetMask(), gw = Network.gatewayIP();
+    len = snprintf_P(json, cap, PSTR("{\"config\":{\"ip\":\"%u.%u.%u.%u\",\"nm\":\"%u.%u.%u.%u\",\"gw\":\"%u.%u.%u.%u\",\"ports\":[{\"port\":\"0\",\"ts\":\"0\",\"l\":\"%u\",\"ss\":\"0\"}]}}"),
+                     ip[0], ip[1], ip[2], ip[3], nm[0], nm[1], nm[2], nm[3], gw[0], gw[1], gw[2], gw[3], strip.getLengthTotal());
+  }
+  if (len <= 0 || len >= (int)cap) return;
+
+  /*0*/buf[0] = DDP_FLAGS1_VER1 | DDP_FLAGS1_REPLY | DDP_FLAGS1_PUSH;
+  /*1*/buf[1] = seq;
+  /*2*/buf[2] = 0;
+  /*3*/buf[3] = id;
+  /*4-7*/memset(buf + 4, 0, 4); //offset
+  /*8*/buf[8] = 0xFF & (len >> 8);
+  /*9*/buf[9] = 0xFF & (len     );
+  //sent by the listening socket, so the reply comes from port 4048 like the sender expects
+  ddp.writeTo(buf, DDP_HEADER_LEN + len, client, port);
+}
@@ -3,33 +3,310 @@
 #include "const.h"
 
 //threading/network callback details: https://github.com/Aircoookie/WLED/pull/2336#discussion_r762276994
-bool requestJSONBufferLock(uint8_t module)
+//JSON document pool: slot 0 is the static full size document, the other slots are JSON_POOL_SLOT_SIZE
+//heap documents allocated once by initJSONPool() and cleared on acquire. Larger requests only get slot 0.
+//Acquiring never blocks the network callbacks, callers answer "busy" (ERR_NOBUF) instead.
+#ifndef WLED_USE_DYNAMIC_JSON
+static StaticJsonDocument<JSON_BUFFER_SIZE> jsonDoc;
+static JsonDocument* jsonPool[JSON_POOL_SLOTS] = {&jsonDoc};
+static volatile uint8_t jsonPoolOwner[JSON_POOL_SLOTS]; //module holding the slot, 0 = free
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE jsonPoolMux = portMUX_INITIALIZER_UNLOCKED;
+#define JSON_POOL_LOCK()   portENTER_CRITICAL(&jsonPoolMux)
+#define JSON_POOL_UNLOCK() portEXIT_CRITICAL(&jsonPoolMux)
+#else
+#define JSON_POOL_LOCK()
+#define JSON_POOL_UNLOCK()
+#endif
+static uint32_t jsonPoolAcquired = 0, jsonPoolBusy = 0;
+static uint8_t jsonPoolPeak = 0, jsonPoolHeapSlots = 0;
+
+//claims a free slot able to hold size bytes, small requests prefer a heap slot to keep the static document available
+//heapOnly requests (held over many loops) leave the static document alone while a heap slot exists
+static int8_t claimJSONSlot(uint8_t module, size_t size, bool heapOnly) {
+  int8_t slot = -1;
+  uint8_t used = 1;
+  bool small = size <= JSON_POOL_SLOT_SIZE;
+  JSON_POOL_LOCK();
+  for (uint8_t i = 0; i < JSON_POOL_SLOTS; i++) {
+    uint8_t s = small ? (i + 1) % JSON_POOL_SLOTS : i;
+    if (jsonPoolOwner[s]) { used++; continue; }
+    if (slot >= 0 || !jsonPool[s] || (s && !small) || (!s && heapOnly && jsonPoolHeapSlots)) continue;
+    jsonPoolOwner[s] = module;
+    slot = s;
+  }
+  if (slot >= 0 && used > jsonPoolPeak) jsonPoolPeak = used;
+  JSON_POOL_UNLOCK();
+  return slot;
+}
+
+static uint8_t usedJSONSlots() {
+  uint8_t used = 0;
+  for (uint8_t s = 0; s < JSON_POOL_SLOTS; s++) if (jsonPoolOwner[s]) used++;
+  return used;
+}
+
+JsonDocument* requestJSONBuffer(uint8_t module, size_t size, uint16_t waitMs, bool heapOnly)
 {
+  if (!module) module = 255;
   unsigned long now = millis();
+  int8_t slot;
+  while ((slot = claimJSONSlot(module, size, heapOnly)) < 0 && millis() - now < waitMs) delay(1);
+
+  if (slot < 0) {
+    jsonPoolBusy++;
+    DEBUG_PRINT(F("ERROR: JSON buffer busy! ("));
+    DEBUG_PRINT(module);
+    DEBUG_PRINT(',');
+    DEBUG_PRINT(jsonPoolOwner[0]);
+    DEBUG_PRINTLN(")");
+    return nullptr;
+  }
+
+  jsonPool[slot]->clear();
+  jsonPoolAcquired++;
+  DEBUG_PRINT(F("JSON buffer locked. ("));
+  DEBUG_PRINT(module);
+  DEBUG_PRINT(',');
+  DEBUG_PRINT(slot);
+  DEBUG_PRINTLN(")");
+  return jsonPool[slot];
+}
 
-  while (jsonBufferLock && millis()-now < 1000) delay(1); // wait for a second for buffer lock
 
-  if (millis()-now >= 1000) {
-    DEBUG_PRINT(F("ERROR: Locking JSON buffer failed! ("));
-    DEBUG_PRINT(jsonBufferLock);
+void releaseJSONBuffer(JsonDocument* d)
+{
+  if (!d) return;
+  for (uint8_t s = 0; s < JSON_POOL_SLOTS; s++) {
+    if (jsonPool[s] != d || !jsonPoolOwner[s]) continue;
+    DEBUG_PRINT(F("JSON buffer released. ("));
+    DEBUG_PRINT(jsonPoolOwner[s]);
     DEBUG_PRINTLN(")");
-    return false; // waiting time-outed
+    jsonPoolOwner[s] = 0;
+    return;
+  }
+}
+
+
+bool jsonBufferAvailable()
+{
+  return usedJSONSlots() < JSON_POOL_SLOTS;
+}
+
+
+void serializeJSONPool(JsonObject root)
+{
+  root["n"]           = JSON_POOL_SLOTS;
+  root[F("heap")]     = jsonPoolHeapSlots; //heap slots allocated at boot
+  root[F("size")]     = JSON_POOL_SLOT_SIZE;
+  root[F("used")]     = usedJSONSlots();
+  root[F("peak")]     = jsonPoolPeak;
+  root[F("acq")]      = jsonPoolAcquired;
+  root[F("busy")]     = jsonPoolBusy;
+  root[F("lock")]     = jsonPoolOwner[0]; //module holding the static document
+}
+#else
+JsonDocument* requestJSONBuffer(uint8_t module, size_t size, uint16_t waitMs, bool heapOnly) { return nullptr; }
+void releaseJSONBuffer(JsonDocument* d) {}
+bool jsonBufferAvailable() { return true; }
+void serializeJSONPool(JsonObject root) {}
+#endif
+
+
+//deserializeState() runs in the loop and in the async webserver/MQTT tasks on ESP32, it is serialized by
+//a recursive mutex (presets apply states from within a state). The document a state is applied from is
+//lent to presets loaded or saved by it, instead of them taking another pool slot.
+static JsonDocument* stateApplyDoc = nullptr;
+#ifdef ARDUINO_ARCH_ESP32
+static SemaphoreHandle_t stateApplyMutex = nullptr;
+#endif
+
+//called once at boot, before the network is started
+void initJSONPool()
+{
+  #ifdef ARDUINO_ARCH_ESP32
+  if (!stateApplyMutex) stateApplyMutex = xSemaphoreCreateRecursiveMutex();
+  #endif
+  #ifndef WLED_USE_DYNAMIC_JSON
+  for (uint8_t s = 1; s < JSON_POOL_SLOTS; s++) {
+    if (jsonPool[s]) continue;
+    DynamicJsonDocument* d = new DynamicJsonDocument(JSON_POOL_SLOT_SIZE);
+    if (d && !d->capacity()) { delete d; d = nullptr; }
+    if (!d) { DEBUG_PRINTLN(F("JSON pool slot alloc failed!")); break; }
+    jsonPool[s] = d;
+    jsonPoolHeapSlots++;
   }
+  #endif
+}
 
-  jsonBufferLock = module ? module : 255;
-  fileDoc = &doc;  // used for applying presets (presets.cpp)
-  doc.clear();
+//takes the state lock, doc (if not nullptr) is lent to presets until unlockStateApply(), returns the previous one
+JsonDocument* lockStateApply(JsonDocument* doc)
+{
+  #ifdef ARDUINO_ARCH_ESP32
+  if (stateApplyMutex) xSemaphoreTakeRecursive(stateApplyMutex, portMAX_DELAY);
+  #endif
+  JsonDocument* prev = stateApplyDoc;
+  if (doc) stateApplyDoc = doc;
+  return prev;
+}
+
+void unlockStateApply(JsonDocument* prev)
+{
+  stateApplyDoc = prev;
+  #ifdef ARDUINO_ARCH_ESP32
+  if (stateApplyMutex) xSemaphoreGiveRecursive(stateApplyMutex);
+  #endif
+}
+
+//the document of the state being applied by the calling task (i.e. the JSON API request being handled), if any
+//presets loaded or saved from within that state reuse it instead of taking another slot
+JsonDocument* ownJSONBuffer()
+{
+  #ifdef ARDUINO_ARCH_ESP32
+  if (!stateApplyMutex || xSemaphoreGetMutexHolder(stateApplyMutex) != xTaskGetCurrentTaskHandle()) return nullptr;
+  #endif
+  return stateApplyDoc;
+}
+
+
+//JSON API messages from UDP and MQTT are parsed in one arena that is allocated at boot and kept,
+//instead of a heap document per message, and are rate limited so a flood cannot starve the loop.
+//Over the limit the latest message is kept and applied by handleRemoteAPI() once allowed again,
+//so the final state of a burst (e.g. a slider dragged in home automation) is never lost
+static DynamicJsonDocument* remoteDoc = nullptr;
+static volatile bool remoteDocBusy = false; //MQTT callbacks run in another task on ESP32
+static RemoteQueue remoteQueue(REMOTE_API_RATE, REMOTE_API_BURST);
+static uint32_t remoteHandled = 0, remoteRejected = 0;
+#ifdef ARDUINO_ARCH_ESP32
+//remoteDocBusy and the queue are shared by the loop and the MQTT task
+static portMUX_TYPE remoteMux = portMUX_INITIALIZER_UNLOCKED;
+#define REMOTE_LOCK()   portENTER_CRITICAL(&remoteMux)
+#define REMOTE_UNLOCK() portEXIT_CRITICAL(&remoteMux)
+#else
+#define REMOTE_LOCK()
+#define REMOTE_UNLOCK()
+#endif
+
+//called once at boot, before the network is started
+void initRemoteAPI()
+{
+  if (remoteDoc) return;
+  remoteDoc = new DynamicJsonDocument(REMOTE_JSON_SIZE);
+  if (remoteDoc && !remoteDoc->capacity()) { delete remoteDoc; remoteDoc = nullptr; }
+  if (!remoteDoc) DEBUG_PRINTLN(F("Remote API arena alloc failed!"));
+}
+
+static bool remoteAPIAllowed()
+{
+  REMOTE_LOCK();
+  bool ok = remoteQueue.allow(millis());
+  REMOTE_UNLOCK();
+  return ok;
+}
+
+//keeps a message over the rate limit, replacing the one kept before
+static void deferRemoteAPI(const char* msg, size_t len, bool set)
+{
+  char* copy = (char*)malloc(len + 1);
+  if (copy) { memcpy(copy, msg, len); copy[len] = '\0'; }
+  REMOTE_LOCK();
+  char* old = remoteQueue.defer(copy, len, set);
+  REMOTE_UNLOCK();
+  free(old);
+}
+
+static DeserializationError applyRemoteDoc(JsonDocument& doc, const char* in, size_t len)
+{
+  return parseRemoteDoc(doc, in, len, [](JsonObject root) { deserializeState(root); });
+}
+
+//parses a message in the arena, or in a JSON pool document if allowed and it does not fit or the arena is busy
+static bool parseRemoteJSON(const char* json, size_t len, bool allowPool)
+{
+  bool claimed = false;
+  REMOTE_LOCK();
+  if (!remoteDocBusy) remoteDocBusy = claimed = true;
+  REMOTE_UNLOCK();
+
+  DeserializationError error = DeserializationError::NoMemory;
+  if (claimed && remoteDoc) {
+    error = applyRemoteDoc(*remoteDoc, json, len);
+    remoteDoc->clear();
+  }
+  if (claimed) remoteDocBusy = false;
+
+  if (error == DeserializationError::NoMemory && allowPool) {
+    #ifdef WLED_USE_DYNAMIC_JSON
+    DynamicJsonDocument doc(JSON_BUFFER_SIZE);
+    #else
+    JsonDocument* pDoc = requestJSONBuffer(15);
+    if (!pDoc) { remoteRejected++; return false; }
+    JsonDocument& doc = *pDoc;
+    #endif
+    error = applyRemoteDoc(doc, json, len);
+    releaseJSONBuffer(&doc);
+  }
+
+  if (error) {
+    remoteRejected++;
+    return false;
+  }
+  remoteHandled++;
   return true;
 }
 
+//applies a JSON API message (JSON text or a MessagePack map), false if rejected or deferred by the rate limit
+//allowPool: messages too large for the arena (MQTT) may use a JSON pool document
+bool applyRemoteJSON(const char* json, size_t len, bool allowPool)
+{
+  if (!remoteAPIAllowed()) {
+    deferRemoteAPI(json, len, false);
+    return false;
+  }
+  return parseRemoteJSON(json, len, allowPool);
+}
 
-void releaseJSONBufferLock()
+//applies an HTTP API request without the "win&" prefix, false if deferred by the rate limit
+bool applyRemoteSet(const char* req, size_t len)
 {
-  DEBUG_PRINT(F("JSON buffer released. ("));
-  DEBUG_PRINT(jsonBufferLock);
-  DEBUG_PRINTLN(")");
-  fileDoc = nullptr;
-  jsonBufferLock = 0;
+  if (!remoteAPIAllowed()) {
+    deferRemoteAPI(req, len, true);
+    return false;
+  }
+  String apireq = "win&";
+  apireq += req;
+  handleSet(nullptr, apireq);
+  remoteHandled++;
+  return true;
+}
+
+//called by the loop: applies the message kept over the rate limit once allowed
+void handleRemoteAPI()
+{
+  if (!remoteQueue.pending) return;
+  size_t len;
+  bool set;
+  REMOTE_LOCK();
+  char* msg = remoteQueue.next(millis(), len, set);
+  REMOTE_UNLOCK();
+  if (!msg) return;
+  if (set) {
+    String apireq = "win&";
+    apireq += msg;
+    handleSet(nullptr, apireq);
+    remoteHandled++;
+  } else {
+    parseRemoteJSON(msg, len, true);
+  }
+  free(msg);
+}
+
+void serializeRemoteAPI(JsonObject root)
+{
+  root[F("arena")] = remoteDoc ? REMOTE_JSON_SIZE : 0;
+  root[F("ok")]    = remoteHandled;
+  root[F("limit")] = remoteQueue.limited;
+  root[F("rej")]   = remoteRejected;
 }
 
 
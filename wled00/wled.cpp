@@ -130,6 +130,8 @@ void WLED::loop()
   handleConnection();
   handleSerial();
   handleNotifications();
+  handleRemoteAPI();
+  expireJsonCache();
   handleTransitions();
 #ifdef WLED_ENABLE_DMX
   handleDMX();
@@ -153,15 +155,18 @@ void WLED::loop()
   #endif
 
   yield();
+  handleStateUpdates(); //everything changed since the last frame
 
-  if (doReboot && !doInitBusses) // if busses have to be inited & saved, wait until next iteration
+  if (doReboot && !doInitBusses && !doSerializeConfig) { // if busses have to be inited & saved, wait until next iteration
+    handleStateUpdates(true); //notify what is still pending
     reset();
+  }
   if (doCloseFile) {
     closeFile();
     yield();
   }
 
-  if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly))  // block stuff if WARLS/Adalight is enabled
+  if (!realtimeMode || realtimeOverride || (realtimeMode && (useMainSegmentOnly || realtimeRoutesActive())))  // block stuff if WARLS/Adalight is enabled
   {
     if (apActive) dnsServer.processNextRequest();
     #ifndef WLED_DISABLE_OTA
@@ -190,6 +195,10 @@ void WLED::loop()
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
 #endif
   }
+  else if (rtInterpolate) strip.service(); //renders interpolated realtime frames
+  #ifdef WLED_ENABLE_RECORDER
+  busses.flushRecorders(); //outside show(), file system access may take long
+  #endif
   yield();
 #ifdef ESP8266
   MDNS.update();
@@ -213,25 +222,21 @@ void WLED::loop()
   }
 
   //LED settings have been saved, re-init busses
-  //This code block causes severe FPS drop on ESP32 with the original "if (busConfigs[0] != nullptr)" conditional. Investigate! 
+  //only busses whose type, pins or length changed are rebuilt, the others keep running
   if (doInitBusses) {
     doInitBusses = false;
     DEBUG_PRINTLN(F("Re-init busses."));
     bool aligned = strip.checkSegmentAlignment(); //see if old segments match old bus(ses)
-    busses.removeAll();
-    uint32_t mem = 0;
-    for (uint8_t i = 0; i < WLED_MAX_BUSSES; i++) {
-      if (busConfigs[i] == nullptr) break;
-      mem += BusManager::memUsage(*busConfigs[i]);
-      if (mem <= MAX_LED_MEMORY) {
-        busses.add(*busConfigs[i]);
-      }
-      delete busConfigs[i]; busConfigs[i] = nullptr;
-    }
-    strip.finalizeInit();
-    loadLedmap = 0;
+    uint8_t rebuilt = busses.reconfigure(busConfigs);
+    strip.finalizeInit(false);
+    if (rebuilt) loadLedmap = 0;
     if (aligned) strip.makeAutoSegments();
     else strip.fixInvalidSegments();
+    doSerializeConfig = true;
+  }
+  //write config to flash only once no bus is outputting, flash access stalls RMT/I2S on ESP32
+  if (doSerializeConfig && !strip.isUpdating()) {
+    doSerializeConfig = false;
     yield();
     serializeConfig();
   }
@@ -302,6 +307,9 @@ void WLED::setup()
   DEBUG_PRINT(F("heap "));
   DEBUG_PRINTLN(ESP.getFreeHeap());
 
+  initJSONPool();
+  initRemoteAPI();
+
   #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_USE_PSRAM)
   if (psramFound()) {
     // GPIO16/GPIO17 reserved for SPI RAM
@@ -475,7 +483,7 @@ void WLED::initAP(bool resetAP)
     if (udpPort2 > 0 && udpPort2 != ntpLocalPort && udpPort2 != udpPort && udpPort2 != udpRgbPort) {
       udp2Connected = notifier2Udp.begin(udpPort2);
     }
-    e131.begin(false, e131Port, e131Universe, E131_MAX_UNIVERSE_COUNT);
+    e131.begin(false, e131Port, e131Universe);
     ddp.begin(false, DDP_DEFAULT_PORT);
 
     dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
@@ -630,6 +638,7 @@ void WLED::initConnection()
 void WLED::initInterfaces()
 {
   DEBUG_PRINTLN(F("Init STA interfaces"));
+  infoGeneration++;
 
 #ifndef WLED_DISABLE_HUESYNC
   IPAddress ipAddress = Network.localIP();
@@ -678,7 +687,7 @@ void WLED::initInterfaces()
 #ifndef WLED_DISABLE_BLYNK
   initBlynk(blynkApiKey, blynkHost, blynkPort);
 #endif
-  e131.begin(e131Multicast, e131Port, e131Universe, E131_MAX_UNIVERSE_COUNT);
+  e131.begin(e131Multicast, e131Port, e131Universe, e131MulticastUniverses());
   ddp.begin(false, DDP_DEFAULT_PORT);
   reconnectHue();
   initMqtt();
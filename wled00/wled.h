@@ -34,6 +34,7 @@
 #define WLED_ENABLE_ADALIGHT     // saves 500b only (uses GPIO3 (RX) for serial)
 //#define WLED_ENABLE_DMX          // uses 3.5kb (use LEDPIN other than 2)
 //#define WLED_ENABLE_JSONLIVE     // peek LED output via /json/live (WS binary peek is always enabled)
+//#define WLED_ENABLE_RECORDER     // frame recorder bus types (96 RAM, 97 FS), download via /json/rec
 #ifndef WLED_DISABLE_LOXONE
   #define WLED_ENABLE_LOXONE       // uses 1.2kb
 #endif
@@ -80,6 +81,17 @@
   #endif
 #endif
 
+//Filesystem to use for preset and config files. SPIFFS or LittleFS on ESP8266, SPIFFS only on ESP32 (now using LITTLEFS port by lorol)
+#ifdef ESP8266
+  #define WLED_FS LittleFS
+#else
+  #if LOROL_LITTLEFS
+    #define WLED_FS LITTLEFS
+  #else
+    #define WLED_FS LittleFS
+  #endif
+#endif
+
 #include "src/dependencies/network/Network.h"
 
 #ifdef WLED_USE_MY_CONFIG
@@ -149,9 +161,11 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "html_ui.h"
 #include "html_settings.h"
 #include "html_other.h"
+#include "html_palx.h"
 #include "FX.h"
 #include "ir_codes.h"
 #include "const.h"
+#include "api_helpers.h"
 #include "NodeStruct.h"
 #include "pin_manager.h"
 #include "bus_manager.h"
@@ -176,17 +190,6 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
   #include <IRutils.h>
 #endif
 
-//Filesystem to use for preset and config files. SPIFFS or LittleFS on ESP8266, SPIFFS only on ESP32 (now using LITTLEFS port by lorol)
-#ifdef ESP8266
-  #define WLED_FS LittleFS
-#else
-  #if LOROL_LITTLEFS
-    #define WLED_FS LITTLEFS
-  #else
-    #define WLED_FS LittleFS
-  #endif
-#endif
-
 // GLOBAL VARIABLES
 // both declared and defined in header (solution from http://www.keil.com/support/docs/1868.htm)
 //
@@ -363,9 +366,21 @@ WLED_GLOBAL uint16_t e131Port _INIT(5568);                        // DMX in port
 WLED_GLOBAL byte DMXMode _INIT(DMX_MODE_MULTIPLE_RGB);            // DMX mode (s.a.)
 WLED_GLOBAL uint16_t DMXAddress _INIT(1);                         // DMX start address of fixture, a.k.a. first Channel [for E1.31 (sACN) protocol]
 WLED_GLOBAL byte DMXOldDimmer _INIT(0);                           // only update brightness on change
-WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL uint16_t e131FrameTimeout _INIT(15);                  // ms to wait for missing universes (or sync) before showing a frame anyway
+WLED_GLOBAL uint32_t e131Frames _INIT(0);                         // frames shown
+WLED_GLOBAL uint32_t e131TornFrames _INIT(0);                     // frames shown with universes missing
+WLED_GLOBAL uint32_t e131LateFrames _INIT(0);                     // universe packets received after their frame was shown
+WLED_GLOBAL byte rtBufFrames _INIT(0);                            // realtime jitter buffer depth in frames (0 = show frames on arrival)
+WLED_GLOBAL uint16_t rtBufLatency _INIT(50);                      // ms from frame arrival to playout when buffered
+WLED_GLOBAL bool rtInterpolate _INIT(false);                      // blend in-between frames of low rate realtime streams at the target FPS
+WLED_GLOBAL uint16_t rtBufLatencyAvg _INIT(0);                    // measured arrival to playout latency
+WLED_GLOBAL uint16_t rtBufInterval _INIT(0);                      // measured sender frame interval
+WLED_GLOBAL uint32_t rtBufUnderruns _INIT(0);                     // playout found no frame queued
+WLED_GLOBAL uint32_t rtBufOverruns _INIT(0);                      // frames dropped because the buffer was full
+WLED_GLOBAL byte udpMaxPackets _INIT(UDP_MAX_PACKETS_PER_LOOP);    // UDP packets handled per loop() pass at most
+WLED_GLOBAL byte udpMaxMs _INIT(UDP_MAX_MS_PER_LOOP);              // ms spent handling UDP packets per loop() pass at most
 
 WLED_GLOBAL bool mqttEnabled _INIT(false);
 WLED_GLOBAL char mqttDeviceTopic[33] _INIT("");            // main MQTT topic (individual per device, default is wled/mac)
@@ -551,6 +566,10 @@ WLED_GLOBAL bool useMainSegmentOnly _INIT(false);
 WLED_GLOBAL unsigned long lastMqttReconnectAttempt _INIT(0);
 WLED_GLOBAL unsigned long lastInterfaceUpdate _INIT(0);
 WLED_GLOBAL byte interfaceUpdateCallMode _INIT(CALL_MODE_INIT);
+WLED_GLOBAL bool stateUpdatePending _INIT(false);       // stateUpdated() was called, applied by handleStateUpdates()
+WLED_GLOBAL byte stateUpdateMode _INIT(CALL_MODE_INIT);
+WLED_GLOBAL uint32_t stateGeneration _INIT(1);          // bumped on every state change, ETag of /json/state
+WLED_GLOBAL uint32_t infoGeneration _INIT(1);           // bumped on info-relevant events, ETag of /json/info
 WLED_GLOBAL char mqttStatusTopic[40] _INIT("");        // this must be global because of async handlers
 
 // alexa udp
@@ -585,7 +604,6 @@ WLED_GLOBAL uint16_t olen _INIT(0);
 WLED_GLOBAL size_t fsBytesUsed _INIT(0);
 WLED_GLOBAL size_t fsBytesTotal _INIT(0);
 WLED_GLOBAL unsigned long presetsModifiedTime _INIT(0L);
-WLED_GLOBAL JsonDocument* fileDoc;
 WLED_GLOBAL bool doCloseFile _INIT(false);
 
 // presets
@@ -619,16 +637,12 @@ WLED_GLOBAL BusManager busses _INIT(BusManager());
 WLED_GLOBAL WS2812FX strip _INIT(WS2812FX());
 WLED_GLOBAL BusConfig* busConfigs[WLED_MAX_BUSSES] _INIT({nullptr}); //temporary, to remember values from network callback until after
 WLED_GLOBAL bool doInitBusses _INIT(false);
+WLED_GLOBAL bool doSerializeConfig _INIT(false); //deferred config write after bus re-init or when no JSON document was free
 WLED_GLOBAL int8_t loadLedmap _INIT(-1);
 
 // Usermod manager
 WLED_GLOBAL UsermodManager usermods _INIT(UsermodManager());
 
-#ifndef WLED_USE_DYNAMIC_JSON
-// global ArduinoJson buffer
-WLED_GLOBAL StaticJsonDocument<JSON_BUFFER_SIZE> doc;
-#endif
-WLED_GLOBAL volatile uint8_t jsonBufferLock _INIT(0);
 
 // enable additional debug output
 #ifdef WLED_DEBUG
@@ -377,7 +377,9 @@ void deEEP() {
   #ifdef WLED_USE_DYNAMIC_JSON
   DynamicJsonDocument doc(JSON_BUFFER_SIZE);
   #else
-  if (!requestJSONBufferLock(8)) return;
+  JsonDocument* pDoc = requestJSONBuffer(8);
+  if (!pDoc) return;
+  JsonDocument& doc = *pDoc;
   #endif
 
   JsonObject sObj = doc.to<JsonObject>();
@@ -454,13 +456,13 @@ void deEEP() {
   File f = WLED_FS.open("/presets.json", "w");
   if (!f) {
     errorFlag = ERR_FS_GENERAL;
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
     return;
   }
   serializeJson(doc, f);
   f.close();
 
-  releaseJSONBufferLock();
+  releaseJSONBuffer(&doc);
 
   DEBUG_PRINTLN(F("deEEP complete!"));
 }
@@ -11,16 +11,65 @@ enum class AdaState {
   Header_CountHi,
   Header_CountLo,
   Header_CountCheck,
-  Data_Red,
-  Data_Green,
-  Data_Blue,
+  Data,
   TPM2_Header_Type,
   TPM2_Header_CountHi,
   TPM2_Header_CountLo,
+  TPM2_End,
 };
 
+#ifndef ADALIGHT_CHUNK
+#define ADALIGHT_CHUNK 255        //bytes read from the UART at once, a multiple of 3
+#endif
+#ifndef ADALIGHT_RX_BUFFER
+#define ADALIGHT_RX_BUFFER 2048   //UART receive buffer at high baud rates, holds ~13ms at 1.5 Mbaud
+#endif
+
 uint16_t currentBaud = 1152; //default baudrate 115200 (divided by 100)
 
+#ifdef WLED_ENABLE_ADALIGHT
+static auto adaState = AdaState::Header_A;
+static bool adaTpm2 = false;
+static uint32_t adaRemaining = 0; //data bytes left in the current frame
+static uint16_t adaPixel = 0;
+static byte adaCarry[3];          //pixel split between two reads
+static uint8_t adaCarried = 0;
+
+//header is complete, the data of adaLen bytes follows
+static void adalightFrameStart(uint32_t adaLen) {
+  realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+  realtimeStatPacket(REALTIME_MODE_ADALIGHT, adaLen > 0xFFFF ? 0xFFFF : adaLen);
+  adaRemaining = adaLen;
+  adaPixel = 0;
+  adaCarried = 0;
+  adaState = AdaState::Data;
+}
+
+//writes whole pixels of a block in bulk, a trailing partial pixel is kept for the next block
+static void adalightPixels(const byte* buf, uint16_t len) {
+  uint16_t i = 0;
+  if (adaCarried) {
+    while (adaCarried < 3 && i < len) adaCarry[adaCarried++] = buf[i++];
+    if (adaCarried < 3) return;
+    if (!realtimeOverride) setRealtimePixels(adaPixel, adaCarry, 1, 3);
+    adaPixel++;
+    adaCarried = 0;
+  }
+  uint16_t n = (len - i) / 3;
+  if (n && !realtimeOverride) setRealtimePixels(adaPixel, buf + i, n, 3);
+  adaPixel += n;
+  i += n * 3;
+  while (i < len) adaCarry[adaCarried++] = buf[i++];
+}
+
+//all pixel data is in, handleNotifications() shows the frame
+static void adalightFrameDone() {
+  if (!realtimeOverride) e131NewData = true;
+  adaCarried = 0;
+  adaState = adaTpm2 ? AdaState::TPM2_End : AdaState::Header_A;
+}
+#endif
+
 void updateBaudRate(uint32_t rate){
   uint16_t rate100 = rate/100;
   if (rate100 == currentBaud || rate100 < 96) return;
@@ -31,6 +80,9 @@ void updateBaudRate(uint32_t rate){
   }
 
   Serial.flush();
+  #ifdef WLED_ENABLE_ADALIGHT
+  if (rate > 115200) Serial.setRxBufferSize(ADALIGHT_RX_BUFFER);
+  #endif
   Serial.begin(rate);
 }
   
@@ -39,22 +91,35 @@ void handleSerial()
   if (pinManager.isPinAllocated(3)) return;
   
   #ifdef WLED_ENABLE_ADALIGHT
-  static auto state = AdaState::Header_A;
-  static uint16_t count = 0;
-  static uint16_t pixel = 0;
+  static uint32_t count = 0;
   static byte check = 0x00;
-  static byte red   = 0x00;
-  static byte green = 0x00;
 
   while (Serial.available() > 0)
   {
-    yield();
+    //pixel data is read in blocks, never past the end of the frame
+    if (adaState == AdaState::Data) {
+      byte buf[ADALIGHT_CHUNK];
+      uint32_t len = Serial.available();
+      if (len > adaRemaining) len = adaRemaining;
+      if (len > sizeof(buf)) len = sizeof(buf);
+      len = Serial.readBytes(buf, len);
+      if (!len) break;
+      adaRemaining -= len;
+      adalightPixels(buf, len);
+      if (!adaRemaining) {
+        adalightFrameDone();
+        if (!adaTpm2) return; //show this frame before parsing the next one
+      }
+      continue;
+    }
+
     byte next = Serial.peek();
-    switch (state) {
+    switch (adaState) {
       case AdaState::Header_A:
-        if (next == 'A') state = AdaState::Header_d;
+        if (next == 'A') { adaState = AdaState::Header_d; adaTpm2 = false; }
         else if (next == 0xC9) { //TPM2 start byte
-          state = AdaState::TPM2_Header_Type;
+          adaState = AdaState::TPM2_Header_Type;
+          adaTpm2 = true;
         }
         else if (next == 'I') {
           handleImprovPacket();
@@ -101,15 +166,17 @@ void handleSerial()
           #ifdef WLED_USE_DYNAMIC_JSON
           DynamicJsonDocument doc(JSON_BUFFER_SIZE);
           #else
-          if (!requestJSONBufferLock(16)) return;
+          JsonDocument* pDoc = requestJSONBuffer(16);
+          if (!pDoc) return;
+          JsonDocument& doc = *pDoc;
           #endif
           Serial.setTimeout(100);
           DeserializationError error = deserializeJson(doc, Serial);
           if (error) {
-            releaseJSONBufferLock();
+            releaseJSONBuffer(&doc);
             return;
           }
-          verboseResponse = deserializeState(doc.as<JsonObject>());
+          verboseResponse = deserializeState(doc.as<JsonObject>(), CALL_MODE_DIRECT_CHANGE, 0, &doc);
           //only send response if TX pin is unused for other purposes
           if (verboseResponse && (!pinManager.isPinAllocated(1) || pinManager.getPinOwner(1) == PinOwner::DebugOut)) {
             doc.clear();
@@ -121,65 +188,57 @@ void handleSerial()
             serializeJson(doc, Serial);
             Serial.println();
           }
-          releaseJSONBufferLock();
+          releaseJSONBuffer(&doc);
         }
         break;
       case AdaState::Header_d:
-        if (next == 'd') state = AdaState::Header_a;
-        else             state = AdaState::Header_A;
+        if (next == 'd') adaState = AdaState::Header_a;
+        else             adaState = AdaState::Header_A;
         break;
       case AdaState::Header_a:
-        if (next == 'a') state = AdaState::Header_CountHi;
-        else             state = AdaState::Header_A;
+        if (next == 'a') adaState = AdaState::Header_CountHi;
+        else             adaState = AdaState::Header_A;
         break;
       case AdaState::Header_CountHi:
-        pixel = 0;
         count = next * 0x100;
         check = next;
-        state = AdaState::Header_CountLo;
+        adaState = AdaState::Header_CountLo;
         break;
       case AdaState::Header_CountLo:
         count += next + 1;
         check = check ^ next ^ 0x55;
-        state = AdaState::Header_CountCheck;
+        adaState = AdaState::Header_CountCheck;
         break;
       case AdaState::Header_CountCheck:
-        if (check == next) state = AdaState::Data_Red;
-        else               state = AdaState::Header_A;
+        if (check == next) adalightFrameStart(count * 3);
+        else {
+          realtimeStatError(REALTIME_MODE_ADALIGHT);
+          adaState = AdaState::Header_A;
+        }
         break;
       case AdaState::TPM2_Header_Type:
-        state = AdaState::Header_A; //(unsupported) TPM2 command or invalid type
-        if (next == 0xDA) state = AdaState::TPM2_Header_CountHi; //TPM2 data
+        adaState = AdaState::Header_A; //(unsupported) TPM2 command or invalid type
+        if (next == 0xDA) adaState = AdaState::TPM2_Header_CountHi; //TPM2 data
         else if (next == 0xAA) Serial.write(0xAC); //TPM2 ping
         break;
       case AdaState::TPM2_Header_CountHi:
-        pixel = 0;
-        count = (next * 0x100) /3;
-        state = AdaState::TPM2_Header_CountLo;
+        count = next * 0x100;
+        adaState = AdaState::TPM2_Header_CountLo;
         break;
       case AdaState::TPM2_Header_CountLo:
-        count += next /3;
-        state = AdaState::Data_Red;
+        count += next;
+        if (count) adalightFrameStart(count);
+        else adaState = AdaState::TPM2_End;
         break;
-      case AdaState::Data_Red:
-        red   = next;
-        state = AdaState::Data_Green;
-        break;
-      case AdaState::Data_Green:
-        green = next;
-        state = AdaState::Data_Blue;
-        break;
-      case AdaState::Data_Blue:
-        byte blue  = next;
-        if (!realtimeOverride) setRealtimePixel(pixel++, red, green, blue, 0);
-        if (--count > 0) state = AdaState::Data_Red;
-        else {
-          realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
-
-          if (!realtimeOverride) strip.show();
-          state = AdaState::Header_A;
+      case AdaState::TPM2_End:
+        adaState = AdaState::Header_A;
+        if (next != 0x36) { //missing end byte, data was out of step. Keep the byte, it may start the next frame
+          realtimeStatError(REALTIME_MODE_ADALIGHT);
+          continue;
         }
-        break;
+        Serial.read();
+        return; //show this frame before parsing the next one
+      default: break;
     }
     Serial.read(); //discard the byte
   }
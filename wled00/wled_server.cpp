@@ -102,6 +102,22 @@ void initServer()
     serveJson(request);
   });
 
+  //binary pixel data, written to the segment as the body arrives (before the /json handler, which would take it)
+  server.on("/json/pixels", HTTP_POST, [](AsyncWebServerRequest *request){
+    PixelUpload* up = (PixelUpload*)request->_tempObject;
+    char buf[40];
+    if (!up) {
+      request->send(400, "application/json", F("{\"error\":9}"));
+      return;
+    }
+    bool ok = printPixelUploadResult(*up, buf);
+    request->send(ok ? 200 : 400, "application/json", buf);
+  }, nullptr, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+    if (!index) request->_tempObject = calloc(1, sizeof(PixelUpload)); //freed with the request
+    PixelUpload* up = (PixelUpload*)request->_tempObject;
+    if (up) writePixelUpload(*up, data, len);
+  });
+
   AsyncCallbackJsonWebHandler* handler = new AsyncCallbackJsonWebHandler("/json", [](AsyncWebServerRequest *request) {
     bool verboseResponse = false;
     bool isConfig = false;
@@ -109,13 +125,21 @@ void initServer()
       #ifdef WLED_USE_DYNAMIC_JSON
       DynamicJsonDocument doc(JSON_BUFFER_SIZE);
       #else
-      if (!requestJSONBufferLock(14)) return;
+      JsonDocument* pDoc = requestJSONBuffer(14);
+      if (!pDoc) {
+        request->send(503, "application/json", F("{\"error\":3}"));
+        return;
+      }
+      JsonDocument& doc = *pDoc;
       #endif
 
-      DeserializationError error = deserializeJson(doc, (uint8_t*)(request->_tempObject));
+      //same API in MessagePack if the body is sent as such
+      DeserializationError error = isMsgPackMediaType(request->contentType().c_str())
+        ? deserializeMsgPack(doc, (const char*)(request->_tempObject), request->contentLength())
+        : deserializeJson(doc, (uint8_t*)(request->_tempObject));
       JsonObject root = doc.as<JsonObject>();
       if (error || root.isNull()) {
-        releaseJSONBufferLock();
+        releaseJSONBuffer(&doc);
         request->send(400, "application/json", F("{\"error\":9}"));
         return;
       }
@@ -127,11 +151,11 @@ void initServer()
           serializeJson(root,Serial);
           DEBUG_PRINTLN();
         #endif
-        verboseResponse = deserializeState(root);
+        verboseResponse = deserializeState(root, CALL_MODE_DIRECT_CHANGE, 0, &doc);
       } else {
         verboseResponse = deserializeConfig(root); //use verboseResponse to determine whether cfg change should be saved immediately
       }
-      releaseJSONBufferLock();
+      releaseJSONBuffer(&doc);
     }
     if (verboseResponse) {
       if (!isConfig) {
@@ -140,6 +164,11 @@ void initServer()
         serializeConfig(); //Save new settings to FS
       }
     } 
+    if (acceptsMsgPack(request)) {
+      static const uint8_t msgPackSuccess[] PROGMEM = {0x81, 0xA7, 's','u','c','c','e','s','s', 0xC3}; //{"success":true}
+      request->send_P(200, jsonContentType(true), msgPackSuccess, sizeof(msgPackSuccess));
+      return;
+    }
     request->send(200, "application/json", F("{\"success\":true}"));
   });
   server.addHandler(handler);
@@ -10,70 +10,373 @@ unsigned long wsLastLiveTime = 0;
 //uint8_t* wsFrameBuffer = nullptr;
 
 #define WS_LIVE_INTERVAL 40
+#define WS_RETRY_INTERVAL 100  // ms until a broadcast that ran out of memory is tried again
+#define WS_DELTA_MAX_KEYS 32   // fields remembered per segment (and for the top level state)
+#ifdef ESP8266
+  #define WS_MAX_CLIENTS 3     // clients kept by cleanupClients(), all of them are tracked in wsClients
+#elif defined(DEFAULT_MAX_WS_CLIENTS)
+  #define WS_MAX_CLIENTS DEFAULT_MAX_WS_CLIENTS
+#else
+  #define WS_MAX_CLIENTS 8
+#endif
+
+/*
+ * Delta state pushes: clients that sent {"delta":true} get {"seq":n,"delta":{...}} with only the
+ * state fields (and segment fields, tagged with "id") that changed since the last broadcast.
+ * A gap in "seq" means a message was lost, the client sends {"sync":true} for the full state.
+ * Changes are detected with a hash per field of the last broadcast state.
+ * Clients that send {"mp":true} or any MessagePack (binary) frame get binary MessagePack replies.
+ */
+struct WsFieldHash {
+  uint16_t key;  // 0 = unused
+  uint32_t val;
+};
+static WsFieldHash* wsSnap = nullptr;  // row 0: top level state, row id+1: segment id
+static uint8_t wsSnapRows = 0;
+struct WsClientEntry {
+  uint32_t id;   // 0 = unused
+  bool delta;
+  bool msgpack;  // binary MessagePack instead of JSON text
+};
+static WsClientEntry wsClients[WS_MAX_CLIENTS]; //changed by the async_tcp task, read by the loop
+static uint8_t wsDeltaCount = 0, wsMsgPackCount = 0;
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE wsClientsMux = portMUX_INITIALIZER_UNLOCKED;
+#define WS_CLIENTS_LOCK()   portENTER_CRITICAL(&wsClientsMux)
+#define WS_CLIENTS_UNLOCK() portEXIT_CRITICAL(&wsClientsMux)
+#else
+#define WS_CLIENTS_LOCK()
+#define WS_CLIENTS_UNLOCK()
+#endif
+static uint32_t wsSeq = 0;
+static PixelUpload wsUpload;          //binary pixel message spanning several frames/packets
+static uint32_t wsUploadClient = 0;
+static uint8_t* wsMsg = nullptr;         //binary API message spanning several frames/packets
+static size_t wsMsgLen = 0;
+static uint32_t wsMsgClient = 0;
+static bool wsRetry = false;
+static unsigned long wsRetryTime = 0;
+
+//FNV-1a over the serialized value, no buffer needed
+class HashPrint : public Print {
+  public:
+    uint32_t h = 2166136261UL;
+    size_t write(uint8_t c) { h = (h ^ c) * 16777619UL; return 1; }
+};
+
+static uint16_t hashKey(const char* k) {
+  HashPrint hp;
+  hp.print(k);
+  uint16_t h = hp.h ^ (hp.h >> 16);
+  return h ? h : 1;
+}
+
+//connected clients are tracked to know who gets deltas, the full state, JSON or MessagePack
+//the table holds as many clients as cleanupClients() keeps, so every connected client is in it
+//call with WS_CLIENTS_LOCK() held, evicted is set to a client that has to be closed after unlocking
+static WsClientEntry* findWsClient(uint32_t id, bool add, uint32_t* evicted = nullptr) {
+  WsClientEntry* e = nullptr;
+  for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+    if (wsClients[i].id == id) return &wsClients[i];
+    if (add && !wsClients[i].id && !e) e = &wsClients[i];
+  }
+  if (!add) return nullptr;
+  if (!e) { //full, close the oldest client now instead of on the next cleanupClients() (ids increase)
+    e = &wsClients[0];
+    for (uint8_t i = 1; i < WS_MAX_CLIENTS; i++) if (wsClients[i].id < e->id) e = &wsClients[i];
+    if (evicted) *evicted = e->id;
+  }
+  e->id = id; e->delta = false; e->msgpack = false;
+  return e;
+}
+
+//call with WS_CLIENTS_LOCK() held. The delta snapshot is freed by the loop (handleWs()), which uses it
+static void countWsClients() {
+  wsDeltaCount = wsMsgPackCount = 0;
+  for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+    if (!wsClients[i].id) continue;
+    if (wsClients[i].delta)   wsDeltaCount++;
+    if (wsClients[i].msgpack) wsMsgPackCount++;
+  }
+}
+
+//adds (add) or removes a client, or sets its delta/msgpack option (-1: unchanged)
+static void updateWsClient(uint32_t id, bool add, int8_t delta = -1, int8_t msgpack = -1) {
+  uint32_t evicted = 0;
+  WS_CLIENTS_LOCK();
+  WsClientEntry* e = findWsClient(id, add, &evicted);
+  if (e && !add) e->id = 0;
+  if (e && add) {
+    if (delta >= 0)   e->delta = delta;
+    if (msgpack >= 0) e->msgpack = msgpack;
+  }
+  countWsClients();
+  WS_CLIENTS_UNLOCK();
+  if (evicted) {
+    AsyncWebSocketClient* old = ws.client(evicted);
+    if (old) old->close();
+  }
+}
+
+static bool wantsMsgPack(uint32_t id) {
+  WS_CLIENTS_LOCK();
+  WsClientEntry* e = findWsClient(id, false);
+  bool mp = e && e->msgpack;
+  WS_CLIENTS_UNLOCK();
+  return mp;
+}
+
+//serializes a document into a buffer that is shared by all recipients, nullptr if out of memory
+static AsyncWebSocketMessageBuffer* makeWsBuffer(JsonDocument& d, bool msgpack = false) {
+  if (msgpack && !expandSegmentColors(d.containsKey("state") ? d["state"] : d["delta"])) return nullptr;
+  size_t len = msgpack ? measureMsgPack(d) : measureJson(d);
+  size_t heap1 = ESP.getFreeHeap();
+  AsyncWebSocketMessageBuffer* buffer = ws.makeBuffer(len); // will not allocate correct memory sometimes
+  size_t heap2 = ESP.getFreeHeap();
+  if (!buffer || heap1-heap2<len) return nullptr; //unsent buffers are cleaned up by the server
+  if (msgpack) serializeMsgPack(d, (char *)buffer->get(), len);
+  else         serializeJson(d, (char *)buffer->get(), len +1);
+  return buffer;
+}
+
+//appends a fragment to the binary API message being reassembled, false if out of memory
+static bool appendWsMsg(const uint8_t* data, size_t len) {
+  uint8_t* b = (uint8_t*)realloc(wsMsg, wsMsgLen + len);
+  if (!b) return false;
+  wsMsg = b;
+  memcpy(wsMsg + wsMsgLen, data, len);
+  wsMsgLen += len;
+  return true;
+}
+
+//drops the message being reassembled and releases it for other clients
+static void freeWsMsg() {
+  free(wsMsg);
+  wsMsg = nullptr;
+  wsMsgLen = 0;
+  wsMsgClient = 0;
+}
+
+static void ackPixelUpload(AsyncWebSocketClient* client, const PixelUpload& up) {
+  char buf[40];
+  printPixelUploadResult(up, buf);
+  client->text(buf);
+}
+
+//sends a document to the tracked clients that (don't) get deltas, encoded once per format in use
+static bool sendWsGroup(JsonDocument& d, bool delta) {
+  WsClientEntry clients[WS_MAX_CLIENTS];
+  WS_CLIENTS_LOCK();
+  memcpy(clients, wsClients, sizeof(clients));
+  uint8_t mpCount = wsMsgPackCount;
+  WS_CLIENTS_UNLOCK();
+  bool ok = true;
+  for (uint8_t mp = 0; mp < 2; mp++) {
+    if (mp && !mpCount) break;
+    AsyncWebSocketMessageBuffer* buffer = nullptr;
+    for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+      if (!clients[i].id || clients[i].delta != delta || clients[i].msgpack != mp) continue;
+      AsyncWebSocketClient* c = ws.client(clients[i].id);
+      if (!c || c->status() != WS_CONNECTED) continue;
+      if (!buffer) buffer = makeWsBuffer(d, mp);
+      if (!buffer) { ok = false; break; }
+      if (mp) c->binary(buffer); else c->text(buffer);
+    }
+  }
+  return ok;
+}
+
+static bool ensureSnapRows(uint8_t rows) {
+  if (rows <= wsSnapRows) return true;
+  WsFieldHash* s = (WsFieldHash*)realloc(wsSnap, rows * WS_DELTA_MAX_KEYS * sizeof(WsFieldHash));
+  if (!s) return false;
+  memset(s + wsSnapRows * WS_DELTA_MAX_KEYS, 0, (rows - wsSnapRows) * WS_DELTA_MAX_KEYS * sizeof(WsFieldHash));
+  wsSnap = s;
+  wsSnapRows = rows;
+  return true;
+}
+
+//removes the fields of o that did not change and remembers the new ones, true if any are left
+static bool diffWsObject(JsonObject o, uint8_t row, const char* keep) {
+  WsFieldHash* r = wsSnap + row * WS_DELTA_MAX_KEYS;
+  const char* drop[WS_DELTA_MAX_KEYS];
+  uint8_t nDrop = 0;
+  bool changed = false;
+  for (JsonPair kv : o) {
+    const char* k = kv.key().c_str();
+    if (!strcmp(k, keep)) continue;
+    uint16_t kh = hashKey(k);
+    HashPrint hp;
+    serializeJson(kv.value(), hp);
+    WsFieldHash* f = nullptr;
+    for (uint8_t i = 0; i < WS_DELTA_MAX_KEYS; i++) {
+      if (r[i].key == kh) { f = &r[i]; break; }
+      if (!r[i].key && !f) f = &r[i];
+    }
+    if (f && f->key == kh && f->val == hp.h) {
+      if (nDrop < WS_DELTA_MAX_KEYS) drop[nDrop++] = k;
+      continue;
+    }
+    if (f) { f->key = kh; f->val = hp.h; }
+    changed = true;
+  }
+  for (uint8_t i = 0; i < nDrop; i++) o.remove(drop[i]);
+  return changed;
+}
+
+//reduces a serialized state to the changes since the last call, true if anything changed
+static bool diffWsState(JsonObject st) {
+  if (!ensureSnapRows(strip.getLastActiveSegmentId() + 2)) return true; //no memory, send everything
+  bool changed = diffWsObject(st, 0, "seg");
+  JsonArray segs = st["seg"];
+  uint32_t seen = 0;
+  for (size_t i = 0; i < segs.size(); ) {
+    JsonObject so = segs[i];
+    uint8_t id = so["id"];
+    if (id + 1 >= wsSnapRows && !ensureSnapRows(id + 2)) { i++; changed = true; continue; }
+    seen |= 1UL << id;
+    if (diffWsObject(so, id + 1, "id")) { i++; changed = true; }
+    else segs.remove(i);
+  }
+  for (uint8_t id = 0; id + 1 < wsSnapRows; id++) { //segments that were removed
+    WsFieldHash* r = wsSnap + (id + 1) * WS_DELTA_MAX_KEYS;
+    if ((seen & (1UL << id)) || !r[0].key) continue;
+    memset(r, 0, WS_DELTA_MAX_KEYS * sizeof(WsFieldHash));
+    JsonObject so = segs.createNestedObject();
+    so["id"] = id;
+    so["stop"] = 0;
+    changed = true;
+  }
+  if (!segs.size()) st.remove("seg");
+  return changed;
+}
+
+//JSON or MessagePack API message, the reply uses the same encoding
+static void handleWsApi(AsyncWebSocketClient* client, uint8_t* data, size_t len, bool msgpack)
+{
+  bool verboseResponse = false;
+  bool resync = false;
+  { //scope JsonDocument so it releases its buffer
+    #ifdef WLED_USE_DYNAMIC_JSON
+    DynamicJsonDocument doc(JSON_BUFFER_SIZE);
+    #else
+    JsonDocument* pDoc = requestJSONBuffer(11);
+    if (!pDoc) {
+      client->text(F("{\"error\":3}"));
+      return;
+    }
+    JsonDocument& doc = *pDoc;
+    #endif
+
+    DeserializationError error = msgpack ? deserializeMsgPack(doc, data, len) : deserializeJson(doc, data, len);
+    JsonObject root = doc.as<JsonObject>();
+    if (error || root.isNull()) {
+      releaseJSONBuffer(&doc);
+      return;
+    }
+    if (msgpack || root.containsKey("mp")) updateWsClient(client->id(), true, -1, msgpack || root["mp"].as<bool>());
+    if (root["v"] && root.size() == 1) {
+      //if the received value is just "{"v":true}", send only to this client
+      verboseResponse = true;
+    } else if (root.containsKey("lv"))
+    {
+      wsLiveClientId = root["lv"] ? client->id() : 0;
+    } else if (root.containsKey("delta") || root.containsKey("sync") || root.containsKey("mp"))
+    {
+      //subscribe to delta pushes or MessagePack, or full state after a "seq" gap
+      if (root.containsKey("delta")) updateWsClient(client->id(), true, root["delta"].as<bool>());
+      resync = true;
+    } else {
+      verboseResponse = deserializeState(root, CALL_MODE_DIRECT_CHANGE, 0, &doc);
+      if (!interfaceUpdateCallMode && !stateUpdatePending) {
+        //special case, only on playlist load, avoid sending twice in rapid succession
+        if (millis() - lastInterfaceUpdate > (INTERFACE_UPDATE_COOLDOWN -300)) verboseResponse = false;
+      }
+    }
+    releaseJSONBuffer(&doc);
+  }
+  if (resync) { sendDataWs(client); return; }
+  //update if it takes longer than 300ms until next "broadcast"
+  if (verboseResponse && (millis() - lastInterfaceUpdate < (INTERFACE_UPDATE_COOLDOWN -300) || !(interfaceUpdateCallMode || stateUpdatePending))) sendDataWs(client);
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
   if(type == WS_EVT_CONNECT){
     //client connected
+    updateWsClient(client->id(), true);
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
     if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    if (client->id() == wsUploadClient) wsUploadClient = 0;
+    if (client->id() == wsMsgClient) freeWsMsg();
+    updateWsClient(client->id(), false);
   } else if(type == WS_EVT_DATA){
     //data packet
     AwsFrameInfo * info = (AwsFrameInfo*)arg;
     if(info->final && info->index == 0 && info->len == len){
       //the whole message is in a single frame and we got all of its data (max. 1450byte)
-      if(info->opcode == WS_TEXT)
+      //MessagePack frames start with a map, the reply is in MessagePack too
+      bool msgpack = info->opcode == WS_BINARY && isMsgPackMap(data, len);
+      if (info->opcode == WS_BINARY && len > 0 && data[0] == PIXEL_UPLOAD_MAGIC) {
+        PixelUpload up = {};
+        writePixelUpload(up, data, len);
+        ackPixelUpload(client, up);
+        return;
+      }
+      if(info->opcode == WS_TEXT || msgpack)
       {
-        if (len > 0 && len < 10 && data[0] == 'p') {
+        if (!msgpack && len > 0 && len < 10 && data[0] == 'p') {
           //application layer ping/pong heartbeat.
           //client-side socket layer ping packets are unresponded (investigate)
           client->text(F("pong"));
           return;
         }
-        bool verboseResponse = false;
-        { //scope JsonDocument so it releases its buffer
-          #ifdef WLED_USE_DYNAMIC_JSON
-          DynamicJsonDocument doc(JSON_BUFFER_SIZE);
-          #else
-          if (!requestJSONBufferLock(11)) return;
-          #endif
-
-          DeserializationError error = deserializeJson(doc, data, len);
-          JsonObject root = doc.as<JsonObject>();
-          if (error || root.isNull()) {
-            releaseJSONBufferLock();
+        handleWsApi(client, data, len, msgpack);
+      }
+    } else {
+      //message is comprised of multiple frames or the frame is split into multiple packets
+      if (info->message_opcode == WS_BINARY) {
+        bool first = info->num == 0 && info->index == 0;
+        bool last = info->final && (info->index + len) == info->len;
+        if (first && client->id() == wsMsgClient) freeWsMsg(); //previous message was never completed
+        if (first && len > 0 && data[0] == PIXEL_UPLOAD_MAGIC) { //pixel data is written as it arrives
+          if (wsUploadClient && wsUploadClient != client->id()) {
+            client->text(F("{\"error\":3}")); //another client holds the upload
             return;
           }
-          if (root["v"] && root.size() == 1) {
-            //if the received value is just "{"v":true}", send only to this client
-            verboseResponse = true;
-          } else if (root.containsKey("lv"))
-          {
-            wsLiveClientId = root["lv"] ? client->id() : 0;
-          } else {
-            verboseResponse = deserializeState(root);
-            if (!interfaceUpdateCallMode) {
-              //special case, only on playlist load, avoid sending twice in rapid succession
-              if (millis() - lastInterfaceUpdate > (INTERFACE_UPDATE_COOLDOWN -300)) verboseResponse = false;
-            }
+          memset(&wsUpload, 0, sizeof(wsUpload));
+          wsUploadClient = client->id();
+        } else if (first) { //anything else is reassembled and handled as MessagePack
+          if (wsMsgClient && wsMsgClient != client->id()) {
+            client->text(F("{\"error\":3}"));
+            return;
+          }
+          wsMsgLen = 0;
+          wsMsgClient = client->id();
+        }
+        if (client->id() == wsUploadClient) {
+          writePixelUpload(wsUpload, data, len);
+          if (last) {
+            ackPixelUpload(client, wsUpload);
+            wsUploadClient = 0;
           }
-          releaseJSONBufferLock(); // will clean fileDoc
+          return;
+        }
+        if (client->id() != wsMsgClient) return;
+        if (wsMsgLen + len > WS_MAX_MSG_SIZE || !appendWsMsg(data, len)) {
+          freeWsMsg();
+          client->text(F("{\"error\":9}"));
+          return;
         }
-        //update if it takes longer than 300ms until next "broadcast"
-        if (verboseResponse && (millis() - lastInterfaceUpdate < (INTERFACE_UPDATE_COOLDOWN -300) || !interfaceUpdateCallMode)) sendDataWs(client);
+        if (last) {
+          if (isMsgPackMap(wsMsg, wsMsgLen)) handleWsApi(client, wsMsg, wsMsgLen, true);
+          else client->text(F("{\"error\":9}"));
+          freeWsMsg();
+        }
+        return;
       }
-    } else {
-      //message is comprised of multiple frames or the frame is split into multiple packets
-      //if(info->index == 0){
-        //if (!wsFrameBuffer && len < 4096) wsFrameBuffer = new uint8_t[4096];
-      //}
-
-      //if (wsFrameBuffer && len < 4096 && info->index + info->)
-      //{
-
-      //}
 
       if((info->index + len) == info->len){
         if(info->final){
@@ -92,39 +395,66 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
   }
 }
 
+//full state and info, to one client or to all clients that did not subscribe to deltas
 void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
-  AsyncWebSocketMessageBuffer * buffer;
+  wsRetry = false;
+  byte err = errorFlag; //serializeState() clears it, both messages should report it
+  WS_CLIENTS_LOCK();
+  uint8_t deltaCount = wsDeltaCount, mpCount = wsMsgPackCount;
+  WS_CLIENTS_UNLOCK();
+  bool anyFull = client || ws.count() > deltaCount;
 
+  if (!client && deltaCount) {
+    #ifdef WLED_USE_DYNAMIC_JSON
+    DynamicJsonDocument doc(JSON_BUFFER_SIZE);
+    #else
+    JsonDocument* pDoc = requestJSONBuffer(12);
+    if (!pDoc) { wsRetry = true; wsRetryTime = millis(); return; }
+    JsonDocument& doc = *pDoc;
+    #endif
+    JsonObject delta = doc.createNestedObject("delta");
+    serializeState(delta);
+    if (diffWsState(delta)) {
+      doc["seq"] = ++wsSeq; //sequence advances even if the buffer fails, clients will resync
+      sendWsGroup(doc, true);
+    }
+    releaseJSONBuffer(&doc);
+    errorFlag = err;
+  }
+
+  if (!anyFull) return;
+  bool ok;
   { //scope JsonDocument so it releases its buffer
     #ifdef WLED_USE_DYNAMIC_JSON
     DynamicJsonDocument doc(JSON_BUFFER_SIZE);
     #else
-    if (!requestJSONBufferLock(12)) return;
+    JsonDocument* pDoc = requestJSONBuffer(12);
+    if (!pDoc) { if (!client) { wsRetry = true; wsRetryTime = millis(); } return; }
+    JsonDocument& doc = *pDoc;
     #endif
     JsonObject state = doc.createNestedObject("state");
     serializeState(state);
     JsonObject info  = doc.createNestedObject("info");
     serializeInfo(info);
-    size_t len = measureJson(doc);
-    size_t heap1 = ESP.getFreeHeap();
-    buffer = ws.makeBuffer(len); // will not allocate correct memory sometimes
-    size_t heap2 = ESP.getFreeHeap();
-    if (!buffer || heap1-heap2<len) {
-      releaseJSONBufferLock();
-      ws.closeAll(1013); //code 1013 = temporary overload, try again later
-      ws.cleanupClients(0); //disconnect all clients to release memory
-      return; //out of memory
+    doc["seq"] = wsSeq;
+    if (client) {
+      bool mp = wantsMsgPack(client->id());
+      AsyncWebSocketMessageBuffer* buffer = makeWsBuffer(doc, mp);
+      ok = buffer;
+      if (buffer) { if (mp) client->binary(buffer); else client->text(buffer); }
+    } else if (!deltaCount && !mpCount) {
+      AsyncWebSocketMessageBuffer* buffer = makeWsBuffer(doc);
+      ok = buffer;
+      if (buffer) ws.textAll(buffer);
+    } else {
+      ok = sendWsGroup(doc, false);
     }
-    serializeJson(doc, (char *)buffer->get(), len +1);
-    releaseJSONBufferLock();
-  } 
-  if (client) {
-    client->text(buffer);
-  } else {
-    ws.textAll(buffer);
+    releaseJSONBuffer(&doc);
   }
+  //out of memory, try again shortly instead of dropping the clients
+  if (!ok && !client) { wsRetry = true; wsRetryTime = millis(); }
 }
 
 #define MAX_LIVE_LEDS_WS 256
@@ -160,11 +490,9 @@ void handleWs()
 {
   if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
   {
-    #ifdef ESP8266
-    ws.cleanupClients(3);
-    #else
-    ws.cleanupClients();
-    #endif
+    ws.cleanupClients(WS_MAX_CLIENTS);
+    if (!wsDeltaCount && wsSnap) { free(wsSnap); wsSnap = nullptr; wsSnapRows = 0; } //no delta client left
+    if (wsRetry && millis() - wsRetryTime > WS_RETRY_INTERVAL) sendDataWs();
     bool success = true;
     if (wsLiveClientId)
       success = sendLiveLedsWs(wsLiveClientId);
@@ -325,13 +325,15 @@ void getSettingsJS(byte subPage, char* dest)
     #ifdef WLED_USE_DYNAMIC_JSON
     DynamicJsonDocument doc(3072);
     #else
-    if (!requestJSONBufferLock(6)) return;
+    JsonDocument* pDoc = requestJSONBuffer(6, 3072);
+    if (!pDoc) return;
+    JsonDocument& doc = *pDoc;
     #endif
 
     JsonObject mods = doc.createNestedObject(F("um"));
     usermods.addToConfig(mods);
     if (!mods.isNull()) fillUMPins(mods);
-    releaseJSONBufferLock();
+    releaseJSONBuffer(&doc);
     }
 
     #ifdef WLED_ENABLE_DMX